@@ -0,0 +1,726 @@
+#ifndef AISDI_MAPS_BPLUSTREEMAP_H
+#define AISDI_MAPS_BPLUSTREEMAP_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <tuple>
+
+namespace aisdi {
+
+    //Mapa uporządkowana na B+drzewie: węzeł trzyma do Fanout kluczy obok siebie, więc jedno
+    //sięgnięcie do pamięci załatwia kilka porównań. Elementy leżą wyłącznie w liściach, a liście
+    //są połączone w listę dwukierunkową - iteracja nie wraca do węzłów wewnętrznych.
+    //Klucze w węzłach wewnętrznych są kopiami, więc KeyType musi mieć konstruktor domyślny i przypisanie.
+    template<typename KeyType, typename ValueType, std::size_t Fanout = 16>
+    class BPlusTreeMap {
+        static_assert(Fanout >= 4, "B+tree fanout must be at least 4");
+
+    public:
+        using key_type = KeyType;
+        using mapped_type = ValueType;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using size_type = std::size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+        class ConstIterator;
+
+        class Iterator;
+
+        struct Node;
+        struct Leaf;
+        struct Inner;
+
+        friend class ConstIterator;
+
+        friend class Iterator;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        //Minimalne zapełnienie węzłów (poza korzeniem)
+        static constexpr size_type MIN_LEAF_SIZE = Fanout / 2;
+        static constexpr size_type MAX_INNER_KEYS = Fanout - 1;
+        static constexpr size_type MIN_INNER_KEYS = (Fanout + 1) / 2 - 1;
+        //Przy minimalnym rozgałęzieniu 2 głębokość nie przekroczy liczby bitów size_type
+        static constexpr size_type MAX_DEPTH = sizeof(size_type) * 8;
+
+        BPlusTreeMap() : root(nullptr), head(nullptr), tail(nullptr), height(0), count(0) {}
+
+        BPlusTreeMap(std::initializer_list<value_type> list) : BPlusTreeMap() {
+            for (auto &i: list) {
+                operator[](i.first) = i.second;
+            }
+        }
+
+        BPlusTreeMap(const BPlusTreeMap &other) : BPlusTreeMap() {
+            copyFrom(other);
+        }
+
+        BPlusTreeMap(BPlusTreeMap &&other) : root(other.root), head(other.head), tail(other.tail),
+                                             height(other.height), count(other.count) {
+            other.root = nullptr;
+            other.head = other.tail = nullptr;
+            other.height = 0;
+            other.count = 0;
+        }
+
+        ~BPlusTreeMap() {
+            release();
+        }
+
+        BPlusTreeMap &operator=(const BPlusTreeMap &other) {
+            if (this == &other) return *this;
+            release();
+            copyFrom(other);
+            return *this;
+        }
+
+        BPlusTreeMap &operator=(BPlusTreeMap &&other) {
+            if (this == &other) return *this;
+            release();
+            std::swap(root, other.root);
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(height, other.height);
+            std::swap(count, other.count);
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        mapped_type &operator[](const key_type &key) {
+            return tryEmplace(key).first->second;
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&... args) {
+            if (!root) {
+                Leaf *leaf = new Leaf();
+                root = head = tail = leaf;
+            }
+            PathEntry path[MAX_DEPTH];
+            Leaf *leaf = descend(key, path);
+            size_type index = leaf->lowerBound(key);
+            if (index < leaf->size && !(key < leaf->item(index).first))
+                return {Iterator(this, leaf, index), false};
+
+            if (leaf->size < Fanout) {
+                leaf->insertAt(index, std::piecewise_construct, std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+                ++count;
+                return {Iterator(this, leaf, index), true};
+            }
+
+            Leaf *right = splitLeaf(leaf);
+            Leaf *target = leaf;
+            if (index > leaf->size) {
+                index -= leaf->size;
+                target = right;
+            }
+            target->insertAt(index, std::piecewise_construct, std::forward_as_tuple(key),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+            ++count;
+            insertIntoParent(path, height, leaf, right->item(0).first, right);
+            return {Iterator(this, target, index), true};
+        }
+
+        const mapped_type &valueOf(const key_type &key) const {
+            const_iterator it = find(key);
+            if (it == end()) throw std::out_of_range("Trying to find nonexisting key.");
+            return it->second;
+        }
+
+        mapped_type &valueOf(const key_type &key) {
+            iterator it = find(key);
+            if (it == end()) throw std::out_of_range("Trying to find nonexisting key.");
+            return it->second;
+        }
+
+        const_iterator find(const key_type &key) const {
+            size_type index;
+            Leaf *leaf = findLeaf(key, index);
+            return ConstIterator(this, leaf, index);
+        }
+
+        iterator find(const key_type &key) {
+            size_type index;
+            Leaf *leaf = findLeaf(key, index);
+            return Iterator(this, leaf, index);
+        }
+
+        void remove(const key_type &key) {
+            if (!root) throw std::out_of_range("Trying to erase nonexisting element.");
+            PathEntry path[MAX_DEPTH];
+            Leaf *leaf = descend(key, path);
+            size_type index = leaf->lowerBound(key);
+            if (index == leaf->size || key < leaf->item(index).first)
+                throw std::out_of_range("Trying to erase nonexisting element.");
+            removeFromLeaf(path, leaf, index);
+        }
+
+        void remove(const const_iterator &it) {
+            if (it.map != this || !it.leaf) throw std::out_of_range("Trying to erase end().");
+            remove(it->first);
+        }
+
+        size_type getSize() const {
+            return count;
+        }
+
+        size_type getHeight() const {
+            return root ? height + 1 : 0;
+        }
+
+        bool operator==(const BPlusTreeMap &other) const {
+            if (this == &other) return true;
+            if (count != other.count) return false;
+            //Obie mapy są posortowane, więc wystarczy jedno wspólne przejście po liściach
+            for (auto it = begin(), otherIt = other.begin(); it != end(); ++it, ++otherIt) {
+                if (it->first < otherIt->first || otherIt->first < it->first) return false;
+                if (it->second != otherIt->second) return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const BPlusTreeMap &other) const {
+            return !(*this == other);
+        }
+
+        iterator begin() {
+            return Iterator(this, head && head->size ? head : nullptr, 0);
+        }
+
+        iterator end() {
+            return Iterator(this, nullptr, 0);
+        }
+
+        const_iterator cbegin() const {
+            return ConstIterator(this, head && head->size ? head : nullptr, 0);
+        }
+
+        const_iterator cend() const {
+            return ConstIterator(this, nullptr, 0);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    protected:
+        //Węzeł wewnętrzny na ścieżce od korzenia i numer dziecka, do którego zeszliśmy
+        struct PathEntry {
+            Inner *node;
+            size_type child;
+        };
+
+        Node *root;
+        Leaf *head;
+        Leaf *tail;
+        //Liczba poziomów węzłów wewnętrznych - wszystkie liście leżą na tej samej głębokości
+        size_type height;
+        size_type count;
+
+        //Schodzi do liścia, w którym jest (albo powinien być) klucz, zapisując ścieżkę
+        Leaf *descend(const key_type &key, PathEntry *path) const {
+            Node *node = root;
+            for (size_type level = 0; level < height; ++level) {
+                Inner *inner = static_cast<Inner *>(node);
+                size_type child = inner->upperBound(key);
+                path[level].node = inner;
+                path[level].child = child;
+                node = inner->children[child];
+            }
+            return static_cast<Leaf *>(node);
+        }
+
+        Leaf *findLeaf(const key_type &key, size_type &index) const {
+            index = 0;
+            if (!root) return nullptr;
+            Node *node = root;
+            for (size_type level = 0; level < height; ++level) {
+                Inner *inner = static_cast<Inner *>(node);
+                node = inner->children[inner->upperBound(key)];
+            }
+            Leaf *leaf = static_cast<Leaf *>(node);
+            index = leaf->lowerBound(key);
+            if (index < leaf->size && !(key < leaf->item(index).first)) return leaf;
+            index = 0;
+            return nullptr;
+        }
+
+        //Przenosi górną połowę pełnego liścia do nowego liścia wpiętego za nim
+        Leaf *splitLeaf(Leaf *leaf) {
+            Leaf *right = new Leaf();
+            for (size_type i = MIN_LEAF_SIZE; i < leaf->size; ++i) {
+                right->construct(i - MIN_LEAF_SIZE, std::move(leaf->item(i)));
+                leaf->destroy(i);
+            }
+            right->size = leaf->size - MIN_LEAF_SIZE;
+            leaf->size = MIN_LEAF_SIZE;
+            right->previous = leaf;
+            right->next = leaf->next;
+            if (leaf->next) leaf->next->previous = right;
+            else tail = right;
+            leaf->next = right;
+            return right;
+        }
+
+        //Wstawia separator i prawy węzeł nad left; przepełnione węzły dzielimy w górę ścieżki
+        void insertIntoParent(PathEntry *path, size_type level, Node *left, key_type separator, Node *right) {
+            while (level > 0) {
+                --level;
+                Inner *parent = path[level].node;
+                size_type position = path[level].child;
+                if (parent->size < MAX_INNER_KEYS) {
+                    parent->insertAt(position, separator, right);
+                    return;
+                }
+                //Dzielimy na tymczasowych tablicach o jeden większych od węzła
+                key_type keys[Fanout];
+                Node *children[Fanout + 1];
+                for (size_type i = 0, j = 0; i < Fanout; ++i)
+                    keys[i] = i == position ? separator : parent->keys[j++];
+                for (size_type i = 0, j = 0; i < Fanout + 1; ++i)
+                    children[i] = i == position + 1 ? right : parent->children[j++];
+
+                const size_type middle = Fanout / 2;
+                Inner *sibling = new Inner();
+                parent->size = middle;
+                for (size_type i = 0; i < middle; ++i) parent->keys[i] = keys[i];
+                for (size_type i = 0; i <= middle; ++i) parent->children[i] = children[i];
+                sibling->size = Fanout - middle - 1;
+                for (size_type i = 0; i < sibling->size; ++i) sibling->keys[i] = keys[middle + 1 + i];
+                for (size_type i = 0; i <= sibling->size; ++i) sibling->children[i] = children[middle + 1 + i];
+
+                left = parent;
+                separator = keys[middle];
+                right = sibling;
+            }
+            Inner *newRoot = new Inner();
+            newRoot->size = 1;
+            newRoot->keys[0] = separator;
+            newRoot->children[0] = left;
+            newRoot->children[1] = right;
+            root = newRoot;
+            ++height;
+        }
+
+        //Usuwa element z liścia i naprawia niedomiar pożyczając od sąsiada albo scalając węzły
+        void removeFromLeaf(PathEntry *path, Leaf *leaf, size_type index) {
+            leaf->eraseAt(index);
+            --count;
+            if (height == 0) {
+                if (leaf->size == 0) {
+                    delete leaf;
+                    root = head = tail = nullptr;
+                }
+                return;
+            }
+            if (leaf->size >= MIN_LEAF_SIZE) return;
+
+            Inner *parent = path[height - 1].node;
+            size_type position = path[height - 1].child;
+            Leaf *left = position > 0 ? static_cast<Leaf *>(parent->children[position - 1]) : nullptr;
+            Leaf *right = position < parent->size ? static_cast<Leaf *>(parent->children[position + 1]) : nullptr;
+
+            if (left && left->size > MIN_LEAF_SIZE) {
+                leaf->insertAt(0, std::move(left->item(left->size - 1)));
+                left->eraseAt(left->size - 1);
+                parent->keys[position - 1] = leaf->item(0).first;
+                return;
+            }
+            if (right && right->size > MIN_LEAF_SIZE) {
+                leaf->insertAt(leaf->size, std::move(right->item(0)));
+                right->eraseAt(0);
+                parent->keys[position] = right->item(0).first;
+                return;
+            }
+            if (left) {
+                mergeLeaves(left, leaf);
+                removeFromInner(path, height - 1, position - 1);
+            } else {
+                mergeLeaves(leaf, right);
+                removeFromInner(path, height - 1, position);
+            }
+        }
+
+        //Dołącza elementy right na koniec left i usuwa right z listy liści
+        void mergeLeaves(Leaf *left, Leaf *right) {
+            for (size_type i = 0; i < right->size; ++i) {
+                left->construct(left->size + i, std::move(right->item(i)));
+                right->destroy(i);
+            }
+            left->size += right->size;
+            right->size = 0;
+            left->next = right->next;
+            if (right->next) right->next->previous = left;
+            else tail = left;
+            delete right;
+        }
+
+        //Usuwa z węzła na poziomie level klucz keyIndex i dziecko keyIndex + 1 (już scalone w lewe)
+        void removeFromInner(PathEntry *path, size_type level, size_type keyIndex) {
+            while (true) {
+                Inner *node = path[level].node;
+                node->eraseAt(keyIndex);
+                if (level == 0) {
+                    if (node->size == 0) {
+                        root = node->children[0];
+                        delete node;
+                        --height;
+                    }
+                    return;
+                }
+                if (node->size >= MIN_INNER_KEYS) return;
+
+                Inner *parent = path[level - 1].node;
+                size_type position = path[level - 1].child;
+                Inner *left = position > 0 ? static_cast<Inner *>(parent->children[position - 1]) : nullptr;
+                Inner *right = position < parent->size ? static_cast<Inner *>(parent->children[position + 1]) : nullptr;
+
+                if (left && left->size > MIN_INNER_KEYS) {
+                    node->insertFront(parent->keys[position - 1], left->children[left->size]);
+                    parent->keys[position - 1] = left->keys[left->size - 1];
+                    --left->size;
+                    return;
+                }
+                if (right && right->size > MIN_INNER_KEYS) {
+                    node->keys[node->size] = parent->keys[position];
+                    node->children[node->size + 1] = right->children[0];
+                    ++node->size;
+                    parent->keys[position] = right->keys[0];
+                    right->eraseFront();
+                    return;
+                }
+                if (left) {
+                    mergeInner(left, parent->keys[position - 1], node);
+                    keyIndex = position - 1;
+                } else {
+                    mergeInner(node, parent->keys[position], right);
+                    keyIndex = position;
+                }
+                --level;
+            }
+        }
+
+        static void mergeInner(Inner *left, const key_type &separator, Inner *right) {
+            left->keys[left->size] = separator;
+            for (size_type i = 0; i < right->size; ++i) left->keys[left->size + 1 + i] = right->keys[i];
+            for (size_type i = 0; i <= right->size; ++i) left->children[left->size + 1 + i] = right->children[i];
+            left->size += right->size + 1;
+            delete right;
+        }
+
+        //Kopia strukturalna: odtwarzamy ten sam kształt drzewa i łączymy liście po kolei
+        void copyFrom(const BPlusTreeMap &other) {
+            if (!other.root) return;
+            Leaf *last = nullptr;
+            root = cloneNode(other.root, other.height, last);
+            tail = last;
+            height = other.height;
+            count = other.count;
+        }
+
+        Node *cloneNode(const Node *source, size_type level, Leaf *&last) {
+            if (level == 0) {
+                const Leaf *sourceLeaf = static_cast<const Leaf *>(source);
+                Leaf *leaf = new Leaf();
+                for (size_type i = 0; i < sourceLeaf->size; ++i) {
+                    leaf->construct(i, sourceLeaf->item(i));
+                    ++leaf->size;
+                }
+                leaf->previous = last;
+                if (last) last->next = leaf;
+                else head = leaf;
+                last = leaf;
+                return leaf;
+            }
+            const Inner *sourceInner = static_cast<const Inner *>(source);
+            Inner *inner = new Inner();
+            for (size_type i = 0; i < sourceInner->size; ++i) inner->keys[i] = sourceInner->keys[i];
+            for (size_type i = 0; i <= sourceInner->size; ++i)
+                inner->children[i] = cloneNode(sourceInner->children[i], level - 1, last);
+            inner->size = sourceInner->size;
+            return inner;
+        }
+
+        void release() {
+            if (root) releaseNode(root, height);
+            root = head = tail = nullptr;
+            height = 0;
+            count = 0;
+        }
+
+        //Głębokość rekursji to wysokość drzewa, czyli log o podstawie Fanout / 2
+        void releaseNode(Node *node, size_type level) {
+            if (level == 0) {
+                Leaf *leaf = static_cast<Leaf *>(node);
+                for (size_type i = 0; i < leaf->size; ++i) leaf->destroy(i);
+                delete leaf;
+                return;
+            }
+            Inner *inner = static_cast<Inner *>(node);
+            for (size_type i = 0; i <= inner->size; ++i) releaseNode(inner->children[i], level - 1);
+            delete inner;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Fanout>
+    struct BPlusTreeMap<KeyType, ValueType, Fanout>::Node {
+        size_type size;
+
+        Node() : size(0) {}
+
+        Node(const Node &) = delete;
+
+        Node &operator=(const Node &) = delete;
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Fanout>
+    struct BPlusTreeMap<KeyType, ValueType, Fanout>::Leaf : public BPlusTreeMap<KeyType, ValueType, Fanout>::Node {
+        using Node::size;
+
+        Leaf *previous;
+        Leaf *next;
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type items[Fanout];
+
+        Leaf() : previous(nullptr), next(nullptr) {}
+
+        value_type &item(size_type index) {
+            return *reinterpret_cast<value_type *>(&items[index]);
+        }
+
+        const value_type &item(size_type index) const {
+            return *reinterpret_cast<const value_type *>(&items[index]);
+        }
+
+        template<typename... Args>
+        void construct(size_type index, Args &&... args) {
+            new(&items[index]) value_type(std::forward<Args>(args)...);
+        }
+
+        void destroy(size_type index) {
+            item(index).~value_type();
+        }
+
+        //Pierwsza pozycja z kluczem nie mniejszym niż key
+        size_type lowerBound(const key_type &key) const {
+            size_type low = 0, high = size;
+            while (low < high) {
+                size_type middle = (low + high) / 2;
+                if (item(middle).first < key) low = middle + 1;
+                else high = middle;
+            }
+            return low;
+        }
+
+        //Elementy mają stały klucz, więc przesuwamy je przez konstrukcję w nowym miejscu
+        template<typename... Args>
+        void insertAt(size_type index, Args &&... args) {
+            for (size_type i = size; i > index; --i) {
+                construct(i, std::move(item(i - 1)));
+                destroy(i - 1);
+            }
+            construct(index, std::forward<Args>(args)...);
+            ++size;
+        }
+
+        void eraseAt(size_type index) {
+            destroy(index);
+            for (size_type i = index + 1; i < size; ++i) {
+                construct(i - 1, std::move(item(i)));
+                destroy(i);
+            }
+            --size;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Fanout>
+    struct BPlusTreeMap<KeyType, ValueType, Fanout>::Inner : public BPlusTreeMap<KeyType, ValueType, Fanout>::Node {
+        using Node::size;
+
+        //Dziecko i trzyma klucze mniejsze od keys[i], dziecko i + 1 klucze nie mniejsze
+        key_type keys[Fanout - 1];
+        Node *children[Fanout];
+
+        //Numer dziecka, do którego należy zejść po key
+        size_type upperBound(const key_type &key) const {
+            size_type low = 0, high = size;
+            while (low < high) {
+                size_type middle = (low + high) / 2;
+                if (key < keys[middle]) high = middle;
+                else low = middle + 1;
+            }
+            return low;
+        }
+
+        //Wstawia klucz na pozycję index i dziecko zaraz za nim
+        void insertAt(size_type index, const key_type &key, Node *child) {
+            for (size_type i = size; i > index; --i) {
+                keys[i] = keys[i - 1];
+                children[i + 1] = children[i];
+            }
+            keys[index] = key;
+            children[index + 1] = child;
+            ++size;
+        }
+
+        void insertFront(const key_type &key, Node *child) {
+            for (size_type i = size; i > 0; --i) keys[i] = keys[i - 1];
+            for (size_type i = size + 1; i > 0; --i) children[i] = children[i - 1];
+            keys[0] = key;
+            children[0] = child;
+            ++size;
+        }
+
+        //Usuwa klucz index i dziecko zaraz za nim
+        void eraseAt(size_type index) {
+            for (size_type i = index + 1; i < size; ++i) {
+                keys[i - 1] = keys[i];
+                children[i] = children[i + 1];
+            }
+            --size;
+        }
+
+        void eraseFront() {
+            for (size_type i = 1; i < size; ++i) keys[i - 1] = keys[i];
+            for (size_type i = 1; i <= size; ++i) children[i - 1] = children[i];
+            --size;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Fanout>
+    class BPlusTreeMap<KeyType, ValueType, Fanout>::ConstIterator {
+    public:
+        using reference = typename BPlusTreeMap::const_reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename BPlusTreeMap::value_type;
+        using pointer = const typename BPlusTreeMap::value_type *;
+
+        friend class BPlusTreeMap;
+
+        explicit ConstIterator(const BPlusTreeMap *mmap, Leaf *tleaf, size_type tindex) :
+                map(mmap), leaf(tleaf), index(tindex) {}
+
+        ConstIterator(const ConstIterator &other) : ConstIterator(other.map, other.leaf, other.index) {}
+
+        ConstIterator &operator++() {
+            if (!leaf) throw std::out_of_range("Trying to increment end()");
+            if (++index == leaf->size) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result(*this);
+            operator++();
+            return result;
+        }
+
+        ConstIterator &operator--() {
+            if (!leaf) {
+                if (!map->tail || map->tail->size == 0) throw std::out_of_range("Trying to decrement begin()");
+                leaf = map->tail;
+                index = leaf->size - 1;
+            } else if (index > 0) {
+                --index;
+            } else {
+                if (!leaf->previous) throw std::out_of_range("Trying to decrement begin()");
+                leaf = leaf->previous;
+                index = leaf->size - 1;
+            }
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result(*this);
+            operator--();
+            return result;
+        }
+
+        reference operator*() const {
+            if (!leaf) throw std::out_of_range("Trying to dereference end().");
+            return leaf->item(index);
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        bool operator==(const ConstIterator &other) const {
+            return this->map == other.map && this->leaf == other.leaf && this->index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const {
+            return !(*this == other);
+        }
+
+    protected:
+        const BPlusTreeMap *map;
+        Leaf *leaf;
+        size_type index;
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Fanout>
+    class BPlusTreeMap<KeyType, ValueType, Fanout>::Iterator
+            : public BPlusTreeMap<KeyType, ValueType, Fanout>::ConstIterator {
+    public:
+        using reference = typename BPlusTreeMap::reference;
+        using pointer = typename BPlusTreeMap::value_type *;
+
+        friend class BPlusTreeMap;
+
+        explicit Iterator(const BPlusTreeMap *mmap, Leaf *tleaf, size_type tindex) :
+                ConstIterator(mmap, tleaf, tindex) {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other) {}
+
+        Iterator &operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+}
+
+#endif /* AISDI_MAPS_BPLUSTREEMAP_H */
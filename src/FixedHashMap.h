@@ -0,0 +1,126 @@
+#ifndef AISDI_MAPS_FIXEDHASHMAP_H
+#define AISDI_MAPS_FIXEDHASHMAP_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <tuple>
+
+#include "Hashing.h"
+#include "RobinHoodTable.h"
+
+namespace aisdi {
+
+    namespace robinhood {
+
+        constexpr std::size_t roundUpToPowerOfTwo(std::size_t n) {
+            std::size_t result = 1;
+            while (result < n) result <<= 1;
+            return result;
+        }
+
+        //Sloty dobieramy tak, by przy pełnej mapie wypełnienie nie przekroczyło 7/8
+        constexpr std::size_t fixedSlotCount(std::size_t capacity) {
+            return roundUpToPowerOfTwo(capacity + capacity / 7 + 1);
+        }
+    }
+
+    //Hashmapa o pojemności znanej w czasie kompilacji: tablica slotów jest częścią obiektu, liczba
+    //slotów i maska są stałymi, a mapa nigdy nie alokuje pamięci. Sondowanie jak w RobinHoodHashMap
+    //(wspólny RobinHoodTable). Przekroczenie Capacity - length_error.
+    template<typename KeyType, typename ValueType, std::size_t Capacity, typename Hash = SeededHash<KeyType>>
+    class FixedHashMap : public RobinHoodTable<KeyType, ValueType, Hash,
+            robinhood::InlineStorage<robinhood::fixedSlotCount(Capacity)>> {
+        static_assert(Capacity > 0, "FixedHashMap capacity must be positive");
+
+        using Table = RobinHoodTable<KeyType, ValueType, Hash,
+                robinhood::InlineStorage<robinhood::fixedSlotCount(Capacity)>>;
+
+    public:
+        using typename Table::key_type;
+        using typename Table::mapped_type;
+        using typename Table::value_type;
+        using typename Table::size_type;
+        using typename Table::iterator;
+        using typename Table::const_iterator;
+
+        static constexpr size_type SLOT_COUNT = robinhood::fixedSlotCount(Capacity);
+        static constexpr size_type MASK = SLOT_COUNT - 1;
+
+        FixedHashMap() = default;
+
+        explicit FixedHashMap(const Hash &hash) : Table(hash) {}
+
+        FixedHashMap(std::initializer_list<value_type> list) : FixedHashMap() {
+            for (auto &i: list) {
+                operator[](i.first) = i.second;
+            }
+        }
+
+        //Ta sama funkcja skrótu i ta sama liczba slotów - kopiujemy slot po slocie bez haszowania
+        FixedHashMap(const FixedHashMap &other) : Table(other.hash_function) {
+            this->copySlotsFrom(other);
+        }
+
+        //Slotów nie da się przejąć, więc przenosimy elementy pojedynczo - nadal bez alokacji
+        FixedHashMap(FixedHashMap &&other) : Table(other.hash_function) {
+            moveFrom(other);
+        }
+
+        FixedHashMap &operator=(const FixedHashMap &other) {
+            if (this == &other) return *this;
+            this->destroyItems();
+            this->hash_function = other.hash_function;
+            this->copySlotsFrom(other);
+            return *this;
+        }
+
+        FixedHashMap &operator=(FixedHashMap &&other) {
+            if (this == &other) return *this;
+            this->destroyItems();
+            this->hash_function = other.hash_function;
+            moveFrom(other);
+            return *this;
+        }
+
+        mapped_type &operator[](const key_type &key) {
+            return tryEmplace(key).first->second;
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&... args) {
+            size_type index = this->findIndex(key);
+            if (index != SLOT_COUNT) return {iterator(this, index), false};
+            if (this->count == Capacity) throw std::length_error("FixedHashMap capacity exceeded.");
+            index = this->insertNew(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+            return {iterator(this, index), true};
+        }
+
+        static constexpr size_type getCapacity() {
+            return Capacity;
+        }
+
+    protected:
+        void moveFrom(FixedHashMap &other) {
+            for (size_type i = 0; i < SLOT_COUNT; i++) {
+                if (other.slot(i).isEmpty()) continue;
+                this->slot(i).construct(other.slot(i).distance, std::move(other.slot(i).item()));
+                other.slot(i).destroy();
+            }
+            this->count = other.count;
+            other.count = 0;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, std::size_t Capacity, typename Hash>
+    constexpr typename FixedHashMap<KeyType, ValueType, Capacity, Hash>::size_type
+            FixedHashMap<KeyType, ValueType, Capacity, Hash>::SLOT_COUNT;
+
+    template<typename KeyType, typename ValueType, std::size_t Capacity, typename Hash>
+    constexpr typename FixedHashMap<KeyType, ValueType, Capacity, Hash>::size_type
+            FixedHashMap<KeyType, ValueType, Capacity, Hash>::MASK;
+}
+
+#endif /* AISDI_MAPS_FIXEDHASHMAP_H */
@@ -0,0 +1,620 @@
+#ifndef AISDI_MAPS_FLATHASHMAP_H
+#define AISDI_MAPS_FLATHASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <functional>
+#include <tuple>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Hashing.h"
+
+namespace aisdi {
+
+    //Sloty są podzielone na grupy po GROUP_WIDTH; jedno porównanie w matcherze sprawdza całą grupę.
+    //Matcher zwraca maskę bitową slotów grupy (spośród zajętych - used), w których leży szukany klucz.
+    namespace flat {
+        static const std::size_t GROUP_WIDTH = 8;
+        static const std::uint32_t FULL_GROUP = (1u << GROUP_WIDTH) - 1;
+
+        //Przenośny matcher - porównuje operatorem == tylko klucze z zajętych slotów,
+        //więc działa dla dowolnego typu klucza
+        struct ScalarMatcher {
+            template<typename KeyType>
+            static std::uint32_t match(const KeyType *keys, std::uint32_t used, const KeyType &key) {
+                std::uint32_t mask = 0;
+                for (std::uint32_t bits = used; bits; bits &= bits - 1) {
+                    unsigned i = static_cast<unsigned>(__builtin_ctz(bits));
+                    if (keys[i] == key) mask |= 1u << i;
+                }
+                return mask;
+            }
+        };
+
+        //Matcher dla kluczy całkowitych bez instrukcji wektorowych: porównuje wszystkie sloty grupy
+        //bez rozgałęzień, wolne sloty odrzuca dopiero maska used
+        struct UnrolledMatcher {
+            template<typename KeyType>
+            static std::uint32_t match(const KeyType *keys, std::uint32_t used, const KeyType &key) {
+                std::uint32_t mask = 0;
+                for (unsigned i = 0; i < GROUP_WIDTH; i++)
+                    mask |= static_cast<std::uint32_t>(keys[i] == key) << i;
+                return mask & used;
+            }
+        };
+
+#if defined(__SSE2__)
+        //Matcher SSE2 (każdy procesor x86-64): 4 klucze 32-bitowe na porównanie. SSE2 nie ma porównania
+        //64-bitowego, więc klucz 64-bitowy jest równy, gdy równe są obie jego połówki.
+        struct Sse2Matcher {
+            template<typename KeyType>
+            static std::uint32_t match(const KeyType *keys, std::uint32_t used, const KeyType &key) {
+                return matchWidth(keys, key, std::integral_constant<std::size_t, sizeof(KeyType)>()) & used;
+            }
+
+        private:
+            template<typename KeyType>
+            static std::uint32_t matchWidth(const KeyType *keys, const KeyType &key,
+                                            std::integral_constant<std::size_t, 4>) {
+                const __m128i needle = _mm_set1_epi32(static_cast<int>(key));
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + 4));
+                const int lowMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, needle)));
+                const int highMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, needle)));
+                return static_cast<std::uint32_t>(lowMask | highMask << 4);
+            }
+
+            template<typename KeyType>
+            static std::uint32_t matchWidth(const KeyType *keys, const KeyType &key,
+                                            std::integral_constant<std::size_t, 8>) {
+                const __m128i needle = _mm_set1_epi64x(static_cast<long long>(key));
+                std::uint32_t mask = 0;
+                for (unsigned i = 0; i < GROUP_WIDTH; i += 2) {
+                    const __m128i halves = _mm_cmpeq_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), needle);
+                    const __m128i both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                    mask |= static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(both))) << i;
+                }
+                return mask;
+            }
+        };
+#endif
+
+#if defined(__AVX2__)
+        //Matcher AVX2 dla kluczy całkowitych: 8 kluczy 32-bitowych jednym porównaniem albo 8 kluczy
+        //64-bitowych dwoma. Wolne sloty też są porównywane (tablica kluczy jest wyzerowana przy alokacji),
+        //a wynik odfiltrowuje maska used.
+        struct Avx2Matcher {
+            template<typename KeyType>
+            static std::uint32_t match(const KeyType *keys, std::uint32_t used, const KeyType &key) {
+                return matchWidth(keys, key, std::integral_constant<std::size_t, sizeof(KeyType)>()) & used;
+            }
+
+        private:
+            template<typename KeyType>
+            static std::uint32_t matchWidth(const KeyType *keys, const KeyType &key,
+                                            std::integral_constant<std::size_t, 4>) {
+                const __m256i needle = _mm256_set1_epi32(static_cast<int>(key));
+                const __m256i window = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys));
+                return static_cast<std::uint32_t>(
+                        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(window, needle))));
+            }
+
+            template<typename KeyType>
+            static std::uint32_t matchWidth(const KeyType *keys, const KeyType &key,
+                                            std::integral_constant<std::size_t, 8>) {
+                const __m256i needle = _mm256_set1_epi64x(static_cast<long long>(key));
+                const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys));
+                const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + 4));
+                const int lowMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(low, needle)));
+                const int highMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(high, needle)));
+                return static_cast<std::uint32_t>(lowMask | highMask << 4);
+            }
+        };
+#endif
+
+        //Całą grupę porównujemy tylko dla liczb całkowitych (i enumów) 32- i 64-bitowych - dla nich równość
+        //to równość bitów, a wolne sloty są wyzerowane. Pozostałe typy idą przez ScalarMatcher.
+        template<typename KeyType,
+                bool Vectorizable = (std::is_integral<KeyType>::value || std::is_enum<KeyType>::value)
+                                    && (sizeof(KeyType) == 4 || sizeof(KeyType) == 8)>
+        struct DefaultMatcher {
+            using type = ScalarMatcher;
+        };
+
+        template<typename KeyType>
+        struct DefaultMatcher<KeyType, true> {
+#if defined(__AVX2__)
+            using type = Avx2Matcher;
+#elif defined(__SSE2__)
+            using type = Sse2Matcher;
+#else
+            using type = UnrolledMatcher;
+#endif
+        };
+
+        //Stan grupy: maska zajętych slotów i liczba elementów, które przy wstawianiu zastały grupę
+        //pełną i leżą dalej. Wyszukiwanie kończy się na pierwszej grupie bez takich elementów.
+        struct GroupState {
+            std::uint32_t used;
+            std::uint32_t overflow;
+        };
+
+        //Iteratory zwracają parę referencji do tablicy kluczy i tablicy wartości - operator-> potrzebuje
+        //obiektu, na który może wskazać
+        template<typename Reference>
+        struct ArrowProxy {
+            const Reference *operator->() const {
+                return &ref;
+            }
+
+            Reference ref;
+        };
+    }
+
+    //Płaska hashmapa w układzie "structure of arrays": klucze i wartości leżą w dwóch osobnych ciągłych
+    //tablicach, więc wyszukiwanie czyta tylko klucze - przy int->int grupa 8 kluczy to 32 bajty zamiast 64.
+    //Sondowanie liniowe po grupach; Matcher (dla kluczy całkowitych AVX2 albo SSE2) porównuje całą grupę naraz.
+    //Hash jak w pozostałych hashmapach - domyślnie SeededHash z ziarnem losowanym dla każdej mapy.
+    template<typename KeyType, typename ValueType, typename Matcher = typename flat::DefaultMatcher<KeyType>::type,
+            typename Hash = SeededHash<KeyType>>
+    class FlatHashMap {
+    public:
+        using key_type = KeyType;
+        using mapped_type = ValueType;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using size_type = std::size_t;
+        using reference = std::pair<const key_type &, mapped_type &>;
+        using const_reference = std::pair<const key_type &, const mapped_type &>;
+        using hasher = Hash;
+
+        class ConstIterator;
+
+        class Iterator;
+
+        friend class ConstIterator;
+
+        friend class Iterator;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        static constexpr size_type INITIAL_CAPACITY = 2 * flat::GROUP_WIDTH;
+
+        FlatHashMap() : keys(nullptr), values(nullptr), groups(nullptr), capacity(0), count(0) {}
+
+        explicit FlatHashMap(const Hash &hash) : FlatHashMap() {
+            hash_function = hash;
+        }
+
+        FlatHashMap(std::initializer_list<value_type> list) : FlatHashMap() {
+            for (auto &i: list) {
+                operator[](i.first) = i.second;
+            }
+        }
+
+        FlatHashMap(const FlatHashMap &other) : FlatHashMap() {
+            copyFrom(other);
+        }
+
+        FlatHashMap(FlatHashMap &&other) : FlatHashMap() {
+            swap(other);
+        }
+
+        ~FlatHashMap() {
+            release();
+        }
+
+        FlatHashMap &operator=(const FlatHashMap &other) {
+            if (this == &other) return *this;
+            release();
+            copyFrom(other);
+            return *this;
+        }
+
+        FlatHashMap &operator=(FlatHashMap &&other) {
+            if (this == &other) return *this;
+            release();
+            swap(other);
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        mapped_type &operator[](const key_type &key) {
+            return valueAt(tryEmplace(key).first.index);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&... args) {
+            size_type hash = hashOf(key);
+            size_type index = findIndex(key, hash);
+            if (index != capacity) return {Iterator(this, index), false};
+            if ((count + 1) * 8 > capacity * 7) rehash(capacity ? capacity * 2 : INITIAL_CAPACITY);
+            index = insertNew(hash, key, std::forward<Args>(args)...);
+            return {Iterator(this, index), true};
+        }
+
+        const mapped_type &valueOf(const key_type &key) const {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to find nonexisting key.");
+            return valueAt(index);
+        }
+
+        mapped_type &valueOf(const key_type &key) {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to find nonexisting key.");
+            return valueAt(index);
+        }
+
+        const_iterator find(const key_type &key) const {
+            return ConstIterator(this, findIndex(key, hashOf(key)));
+        }
+
+        iterator find(const key_type &key) {
+            return Iterator(this, findIndex(key, hashOf(key)));
+        }
+
+        void remove(const key_type &key) {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to erase nonexisting element.");
+            removeAt(index);
+        }
+
+        void remove(const const_iterator &it) {
+            if (it.map != this || it.index >= capacity) throw std::out_of_range("Trying to erase end().");
+            removeAt(it.index);
+        }
+
+        size_type getSize() const {
+            return count;
+        }
+
+        size_type getCapacity() const {
+            return capacity;
+        }
+
+        hasher getHashFunction() const {
+            return hash_function;
+        }
+
+        bool operator==(const FlatHashMap &other) const {
+            if (this == &other) return true;
+            if (count != other.count) return false;
+            for (size_type i = nextUsed(0); i < capacity; i = nextUsed(i + 1)) {
+                size_type index = other.findIndex(keyAt(i), other.hashOf(keyAt(i)));
+                if (index == other.capacity) return false;
+                if (other.valueAt(index) != valueAt(i)) return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const FlatHashMap &other) const {
+            return !(*this == other);
+        }
+
+        iterator begin() {
+            return Iterator(this, nextUsed(0));
+        }
+
+        iterator end() {
+            return Iterator(this, capacity);
+        }
+
+        const_iterator cbegin() const {
+            return ConstIterator(this, nextUsed(0));
+        }
+
+        const_iterator cend() const {
+            return ConstIterator(this, capacity);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    protected:
+        using KeyStorage = typename std::aligned_storage<sizeof(key_type), alignof(key_type)>::type;
+        using ValueStorage = typename std::aligned_storage<sizeof(mapped_type), alignof(mapped_type)>::type;
+
+        KeyStorage *keys;
+        ValueStorage *values;
+        flat::GroupState *groups;
+        size_type capacity;
+        size_type count;
+        Hash hash_function;
+
+        key_type &keyAt(size_type index) {
+            return *reinterpret_cast<key_type *>(&keys[index]);
+        }
+
+        const key_type &keyAt(size_type index) const {
+            return *reinterpret_cast<const key_type *>(&keys[index]);
+        }
+
+        mapped_type &valueAt(size_type index) {
+            return *reinterpret_cast<mapped_type *>(&values[index]);
+        }
+
+        const mapped_type &valueAt(size_type index) const {
+            return *reinterpret_cast<const mapped_type *>(&values[index]);
+        }
+
+        size_type groupMask() const {
+            return capacity / flat::GROUP_WIDTH - 1;
+        }
+
+        //Grupę wybierają młodsze bity, więc funkcja skrótu musi mieszać wszystkie bity, jak SeededHash
+        size_type hashOf(const key_type &key) const {
+            return static_cast<size_type>(hash_function(key));
+        }
+
+        //Grupę odwiedzamy najwyżej raz - bez tego ograniczenia chybione wyszukiwanie mogłoby krążyć,
+        //gdy po usunięciach każda grupa ma jeszcze niezerowy licznik overflow
+        size_type findIndex(const key_type &key, size_type hash) const {
+            if (count == 0) return capacity;
+            size_type mask = groupMask();
+            size_type group = hash & mask;
+            for (size_type step = 0; step <= mask; ++step) {
+                size_type base = group * flat::GROUP_WIDTH;
+                std::uint32_t match = Matcher::match(&keyAt(base), groups[group].used, key);
+                if (match) return base + static_cast<size_type>(__builtin_ctz(match));
+                if (!groups[group].overflow) return capacity;
+                group = (group + 1) & mask;
+            }
+            return capacity;
+        }
+
+        //Element trafia do pierwszej grupy z wolnym slotem. Liczniki overflow mijanych grup zwiększamy
+        //dopiero po udanej konstrukcji klucza i wartości, żeby wyjątek nie zostawił tablicy w złym stanie.
+        template<typename KeyArg, typename... Args>
+        size_type insertNew(size_type hash, KeyArg &&key, Args &&... args) {
+            size_type mask = groupMask();
+            size_type home = hash & mask;
+            size_type group = home;
+            while (groups[group].used == flat::FULL_GROUP) group = (group + 1) & mask;
+            size_type index = group * flat::GROUP_WIDTH
+                              + static_cast<size_type>(__builtin_ctz(~groups[group].used));
+            new(&keys[index]) key_type(std::forward<KeyArg>(key));
+            try {
+                new(&values[index]) mapped_type(std::forward<Args>(args)...);
+            } catch (...) {
+                keyAt(index).~key_type();
+                throw;
+            }
+            for (size_type g = home; g != group; g = (g + 1) & mask) ++groups[g].overflow;
+            groups[group].used |= 1u << (index % flat::GROUP_WIDTH);
+            ++count;
+            return index;
+        }
+
+        void removeAt(size_type index) {
+            size_type mask = groupMask();
+            size_type group = index / flat::GROUP_WIDTH;
+            for (size_type g = hashOf(keyAt(index)) & mask; g != group; g = (g + 1) & mask) --groups[g].overflow;
+            keyAt(index).~key_type();
+            valueAt(index).~mapped_type();
+            groups[group].used &= ~(1u << (index % flat::GROUP_WIDTH));
+            --count;
+        }
+
+        //Klucze trywialne zerujemy, bo matchery całej grupy czytają też wolne sloty
+        void allocate(size_type newCapacity) {
+            keys = new KeyStorage[newCapacity];
+            if (std::is_trivially_copyable<key_type>::value) std::memset(keys, 0, newCapacity * sizeof(KeyStorage));
+            values = new ValueStorage[newCapacity];
+            groups = new flat::GroupState[newCapacity / flat::GROUP_WIDTH]();
+            capacity = newCapacity;
+            count = 0;
+        }
+
+        void rehash(size_type newCapacity) {
+            KeyStorage *oldKeys = keys;
+            ValueStorage *oldValues = values;
+            flat::GroupState *oldGroups = groups;
+            size_type oldCapacity = capacity;
+            allocate(newCapacity);
+            for (size_type i = 0; i < oldCapacity; i++) {
+                if (!((oldGroups[i / flat::GROUP_WIDTH].used >> (i % flat::GROUP_WIDTH)) & 1)) continue;
+                key_type &key = *reinterpret_cast<key_type *>(&oldKeys[i]);
+                mapped_type &value = *reinterpret_cast<mapped_type *>(&oldValues[i]);
+                insertNew(hashOf(key), std::move(key), std::move(value));
+                key.~key_type();
+                value.~mapped_type();
+            }
+            delete[] oldKeys;
+            delete[] oldValues;
+            delete[] oldGroups;
+        }
+
+        //Ta sama funkcja skrótu, te same grupy i te same pozycje - bez ponownego haszowania
+        void copyFrom(const FlatHashMap &other) {
+            hash_function = other.hash_function;
+            if (other.capacity == 0) return;
+            allocate(other.capacity);
+            std::memcpy(groups, other.groups, capacity / flat::GROUP_WIDTH * sizeof(flat::GroupState));
+            for (size_type i = other.nextUsed(0); i < capacity; i = other.nextUsed(i + 1)) {
+                new(&keys[i]) key_type(other.keyAt(i));
+                new(&values[i]) mapped_type(other.valueAt(i));
+            }
+            count = other.count;
+        }
+
+        void release() {
+            if (!std::is_trivially_destructible<key_type>::value || !std::is_trivially_destructible<mapped_type>::value) {
+                for (size_type i = nextUsed(0); i < capacity; i = nextUsed(i + 1)) {
+                    keyAt(i).~key_type();
+                    valueAt(i).~mapped_type();
+                }
+            }
+            delete[] keys;
+            delete[] values;
+            delete[] groups;
+            keys = nullptr;
+            values = nullptr;
+            groups = nullptr;
+            capacity = 0;
+            count = 0;
+        }
+
+        void swap(FlatHashMap &other) {
+            std::swap(keys, other.keys);
+            std::swap(values, other.values);
+            std::swap(groups, other.groups);
+            std::swap(capacity, other.capacity);
+            std::swap(count, other.count);
+            std::swap(hash_function, other.hash_function);
+        }
+
+        //Pierwszy zajęty slot o indeksie >= index albo capacity
+        size_type nextUsed(size_type index) const {
+            while (index < capacity) {
+                size_type group = index / flat::GROUP_WIDTH;
+                std::uint32_t used = groups[group].used >> (index % flat::GROUP_WIDTH);
+                if (used) return index + static_cast<size_type>(__builtin_ctz(used));
+                index = (group + 1) * flat::GROUP_WIDTH;
+            }
+            return capacity;
+        }
+
+        //Ostatni zajęty slot o indeksie < before albo capacity, jeśli takiego nie ma
+        size_type previousUsed(size_type before) const {
+            while (before > 0) {
+                size_type group = (before - 1) / flat::GROUP_WIDTH;
+                size_type shift = 31 - (before - 1) % flat::GROUP_WIDTH;
+                std::uint32_t used = groups[group].used << shift >> shift;
+                if (used) return group * flat::GROUP_WIDTH + 31 - static_cast<size_type>(__builtin_clz(used));
+                before = group * flat::GROUP_WIDTH;
+            }
+            return capacity;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, typename Matcher, typename Hash>
+    class FlatHashMap<KeyType, ValueType, Matcher, Hash>::ConstIterator {
+    public:
+        using reference = typename FlatHashMap::const_reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using pointer = flat::ArrowProxy<reference>;
+
+        friend class FlatHashMap;
+
+        explicit ConstIterator(const FlatHashMap *mmap, size_type tindex) : map(mmap), index(tindex) {}
+
+        ConstIterator(const ConstIterator &other) : ConstIterator(other.map, other.index) {}
+
+        ConstIterator &operator++() {
+            if (index >= map->capacity) throw std::out_of_range("Trying to increment end()");
+            index = map->nextUsed(index + 1);
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result(*this);
+            operator++();
+            return result;
+        }
+
+        ConstIterator &operator--() {
+            size_type previous = map->previousUsed(index);
+            if (previous == map->capacity) throw std::out_of_range("Trying to decrement begin()");
+            index = previous;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result(*this);
+            operator--();
+            return result;
+        }
+
+        reference operator*() const {
+            if (index >= map->capacity) throw std::out_of_range("Trying to dereference end().");
+            return reference(map->keyAt(index), map->valueAt(index));
+        }
+
+        pointer operator->() const {
+            return pointer{this->operator*()};
+        }
+
+        bool operator==(const ConstIterator &other) const {
+            return this->map == other.map && this->index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const {
+            return !(*this == other);
+        }
+
+    protected:
+        const FlatHashMap *map;
+        size_type index;
+    };
+
+    template<typename KeyType, typename ValueType, typename Matcher, typename Hash>
+    class FlatHashMap<KeyType, ValueType, Matcher, Hash>::Iterator
+            : public FlatHashMap<KeyType, ValueType, Matcher, Hash>::ConstIterator {
+    public:
+        using reference = typename FlatHashMap::reference;
+        using pointer = flat::ArrowProxy<reference>;
+
+        friend class FlatHashMap;
+
+        explicit Iterator(const FlatHashMap *mmap, size_type tindex) : ConstIterator(mmap, tindex) {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other) {}
+
+        Iterator &operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        pointer operator->() const {
+            return pointer{this->operator*()};
+        }
+
+        //Pary nie ma w pamięci, więc zamiast rzutowania referencji składamy parę z niestałą wartością
+        reference operator*() const {
+            typename ConstIterator::reference item = ConstIterator::operator*();
+            return reference(item.first, const_cast<mapped_type &>(item.second));
+        }
+    };
+}
+
+#endif /* AISDI_MAPS_FLATHASHMAP_H */
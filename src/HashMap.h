@@ -2,19 +2,28 @@
 #define AISDI_MAPS_HASHMAP_H
 
 #include "TreeMap.h"
+#include "NodePool.h"
+#include "Hashing.h"
 #include <cstddef>
 #include <initializer_list>
 #include <stdexcept>
 #include <utility>
-#include <list>
-#include <array>
 #include <iterator>
-
-#define ARRAY_SIZE 1024
+#include <cstdint>
+#include <tuple>
+#include <memory>
+#include <type_traits>
 
 namespace aisdi {
 
-    template<typename KeyType, typename ValueType>
+    //Hash i KeyEqual są przechowywane w mapie; domyślny SeededHash miesza skrót z ziarnem losowanym dla każdej mapy.
+    //BucketReduction (hashing::ModuloReduction, PowerOfTwoReduction albo FastRangeReduction) wybiera,
+    //jak skrót jest sprowadzany do numeru kubełka.
+    template<typename KeyType, typename ValueType,
+            typename Hash = SeededHash<KeyType>,
+            typename KeyEqual = std::equal_to<KeyType>,
+            typename Allocator = std::allocator<std::pair<const KeyType, ValueType>>,
+            typename BucketReduction = hashing::PowerOfTwoReduction>
     class HashMap {
     public:
         using key_type = KeyType;
@@ -23,18 +32,16 @@ namespace aisdi {
         using size_type = std::size_t;
         using reference = value_type &;
         using const_reference = const value_type &;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Allocator;
 
         class ConstIterator;
 
         class Iterator;
 
-        class List;
-
-        struct BaseNode;
         struct Node;
 
-        friend class List;
-
         friend class ConstIterator;
 
         friend class Iterator;
@@ -42,7 +49,30 @@ namespace aisdi {
         using iterator = Iterator;
         using const_iterator = ConstIterator;
 
-        HashMap() : count(0) {}
+        static constexpr size_type INITIAL_BUCKET_COUNT = 16;
+        static constexpr float DEFAULT_MAX_LOAD_FACTOR = 1.0f;
+        //Do tylu elementów mapa ma jeden kubełek, przeszukiwany liniowo bez haszowania, a nodey leżą
+        //w jednym bloku slabu na stercie (nie w samym obiekcie mapy)
+        static constexpr size_type SMALL_MAP_SIZE = 8;
+
+        //Pusta mapa nie alokuje niczego - pierwsze wstawienie przechodzi w tryb małej mapy,
+        //a tablica kubełków powstaje dopiero po przekroczeniu SMALL_MAP_SIZE elementów
+        HashMap() : array(nullptr), occupied(nullptr), bucket_count(0), first_used(0), count(0),
+                    max_load_factor(DEFAULT_MAX_LOAD_FACTOR), smallHead(nullptr), smallOccupied(0) {}
+
+        explicit HashMap(size_type bucketCount, float maxLoad = DEFAULT_MAX_LOAD_FACTOR,
+                         const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual()) : HashMap() {
+            hash_function = hash;
+            key_eq = equal;
+            if (maxLoad <= 0.0f) throw std::invalid_argument("Max load factor has to be positive.");
+            max_load_factor = maxLoad;
+            rehash(bucketCount);
+        }
+
+        ~HashMap() {
+            clean(*this);
+            releaseBuckets();
+        }
 
         HashMap(std::initializer_list<value_type> list) : HashMap() {
             for (auto i: list) {
@@ -51,36 +81,37 @@ namespace aisdi {
         }
 
         HashMap(const HashMap &other) : HashMap() {
-            for (auto i: other) {
-                operator[](i.first) = i.second;
-            }
+            copyFrom(other);
         }
 
-        HashMap(HashMap &&other) : HashMap() {
-            for (auto i: other) {
-                operator[](i.first) = i.second;
-            }
-            clean(other);
+        //Przeniesienie przejmuje tablicę kubełków, mapę bitową i pulę nodeów - O(1), bez alokacji
+        HashMap(HashMap &&other) : array(nullptr), occupied(nullptr), bucket_count(0), first_used(0), count(0),
+                                   max_load_factor(other.max_load_factor), hash_function(std::move(other.hash_function)),
+                                   key_eq(std::move(other.key_eq)), pool(std::move(other.pool)),
+                                   smallHead(nullptr), smallOccupied(0), slab(std::move(other.slab)) {
+            takeStorage(other);
         }
 
         HashMap &operator=(const HashMap &other) {
-            if (*this == other) return *this;
+            if (this == &other) return *this;
             clean(*this);
-            if (!other.isEmpty())
-                for (auto i: other) {
-                    operator[](i.first) = i.second;
-                }
+            releaseBuckets();
+            forgetStorage();
+            copyFrom(other);
             return *this;
         }
 
         HashMap &operator=(HashMap &&other) {
-            if (*this == other) return *this;
+            if (this == &other) return *this;
             clean(*this);
-            if (!other.isEmpty())
-                for (auto i: other) {
-                    operator[](i.first) = i.second;
-                }
-            clean(other);
+            releaseBuckets();
+            forgetStorage();
+            max_load_factor = other.max_load_factor;
+            hash_function = std::move(other.hash_function);
+            key_eq = std::move(other.key_eq);
+            pool.swap(other.pool);
+            slab.swap(other.slab);
+            takeStorage(other);
             return *this;
         }
 
@@ -89,89 +120,99 @@ namespace aisdi {
         }
 
         mapped_type &operator[](const key_type &key) {
-            size_t index = get_index(key);
-            Node *found;
-            found = array[index].find(key);
-            if (!found) {
-                array[index].append(key, ValueType());
-                ++count;
-                found = array[index].find(key);
-                return found->item.second;
-            } else {
-                return found->item.second;
+            return tryEmplace(key).first->second;
+        }
+
+        //Wstawia element o podanym kluczu (wartość konstruowana z args w miejscu), o ile go nie ma.
+        //Klucz jest haszowany i szukany tylko raz; zwraca iterator na element i informację, czy go wstawiono.
+        template<typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&... args) {
+            size_t index = 0;
+            if (bucket_count) {
+                index = get_index(key);
+                for (Node *x = array[index]; x; x = x->next)
+                    if (key_eq(x->item.first, key)) return {Iterator(this, index, x), false};
+            } else enterSmallMode();
+            if (inSmallMode() ? count == SMALL_MAP_SIZE : needsGrowth(count + 1)) {
+                rehash(inSmallMode() ? INITIAL_BUCKET_COUNT : bucket_count * 2);
+                index = get_index(key);
             }
+            //Nowy element trafia na początek kubełka - nie trzeba szukać końca łańcucha
+            Node *created = createNode(array[index], std::piecewise_construct,
+                                       std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            if (!array[index]) markUsed(index);
+            array[index] = created;
+            ++count;
+            return {Iterator(this, index, created), true};
         }
 
         const mapped_type &valueOf(const key_type &key) const {
-            size_t index = get_index(key);
-            BaseNode *t = array[index].find(key);
+            Node *t = findNode(key);
             if( !t ) throw std::out_of_range("Trying to fin nonexisting key.");
-            return static_cast<Node *>(t)->item.second;
-
+            return t->item.second;
         }
 
         mapped_type &valueOf(const key_type &key) {
-            size_t index = get_index(key);
-            BaseNode *t = array[index].find(key);
+            Node *t = findNode(key);
             if( !t ) throw std::out_of_range("Trying to fin nonexisting key.");
-            return static_cast<Node *>(t)->item.second;
+            return t->item.second;
         }
 
         const_iterator find(const key_type &key) const {
-            std::hash<KeyType> h;
-            size_t index = h(key) % ARRAY_SIZE;
-            Node *result = array[index].find(key);
+            if (count == 0) return cend();
+            size_t index = get_index(key);
+            Node *result = findInBucket(index, key);
             if (!result) return cend();
             return ConstIterator(this, index, result);
         }
 
         iterator find(const key_type &key) {
-            std::hash<KeyType> h;
-            size_t index = h(key) % ARRAY_SIZE;
-            Node *result = array[index].find(key);
+            if (count == 0) return end();
+            size_t index = get_index(key);
+            Node *result = findInBucket(index, key);
             if (!result) return end();
             return Iterator(this, index, result);
         }
 
         void remove(const key_type &key) {
-            std::hash<KeyType> h;
-            size_t index = h(key) % ARRAY_SIZE;
-            BaseNode *result = array[index].find(key);
-            if( !result ) throw std::out_of_range("Trying to erase nonexisting element.");
-            result->next->previous = result->previous;
-            result->previous->next = result->next;
-            delete result;
-            array[index].size--;
-            count--;
+            if (count == 0) throw std::out_of_range("Trying to erase nonexisting element.");
+            size_t index = get_index(key);
+            Node **link = &array[index];
+            while (*link && !key_eq((*link)->item.first, key)) link = &(*link)->next;
+            if( !*link ) throw std::out_of_range("Trying to erase nonexisting element.");
+            unlink(index, link);
         }
 
         void remove(const const_iterator &it) {
             if(it == end()) throw std::out_of_range("Trying to erase end().");
-            BaseNode *result = it.node;
-            result->next->previous = result->previous;
-            result->previous->next = result->next;
-            delete result;
-            array[it.index].size--;
-            count--;
+            Node **link = &array[it.index];
+            while (*link != it.node) link = &(*link)->next;
+            unlink(it.index, link);
         }
 
         size_type getSize() const {
             return count;
         }
 
+        //Każdy klucz szukamy w other tylko raz. Przy tej samej liczbie kubełków i tej samej funkcji skrótu
+        //klucz leży w kubełku o tym samym numerze, więc nie haszujemy go ponownie, a różne mapy bitowe
+        //od razu dają wynik.
         bool operator==(const HashMap &other) const {
-            if((this->getSize() == 0) && (other.getSize() == 0)) return true;
+            if (this == &other) return true;
             if (getSize() != other.getSize()) return false;
-            std::hash<KeyType> h;
-            KeyType key;
-            ValueType val;
-            size_t index;
-            for (auto i: *this) {
-                key = i.first;
-                val = i.second;
-                index = h(key)%1024;
-                if(!other.array[index].find(key)) return false;
-                if (other.array[index].find(key)->item.second != val) return false;
+            if (count == 0) return true;
+            const bool sameLayout = bucket_count == other.bucket_count
+                                    && hashing::sameFunction(hash_function, other.hash_function);
+            if (sameLayout) {
+                for (size_t i = 0; i < bitmapWords(bucket_count); i++)
+                    if (occupied[i] != other.occupied[i]) return false;
+            }
+            for (size_t i = first_used; i < bucket_count; i = nextUsedBucket(i + 1)) {
+                for (Node *x = array[i]; x; x = x->next) {
+                    Node *found = sameLayout ? other.findInBucket(i, x->item.first) : other.findNode(x->item.first);
+                    if (!found) return false;
+                    if (found->item.second != x->item.second) return false;
+                }
             }
             return true;
         }
@@ -180,50 +221,97 @@ namespace aisdi {
             return !(*this == other);
         }
 
-        iterator begin() {
-            BaseNode *result = NULL;
-            size_t first_used_index = 0;
-            for (size_t i = 0; i < ARRAY_SIZE; i++) {
-                if (array[i].size != 0) {
-                    first_used_index = i;
-                    break;
+        size_type getBucketCount() const {
+            return bucket_count;
+        }
+
+        //Długość łańcucha w kubełku o podanym numerze
+        size_type getBucketSize(size_type index) const {
+            if (index >= bucket_count) throw std::out_of_range("Bucket index out of range.");
+            size_type length = 0;
+            for (Node *x = array[index]; x; x = x->next) ++length;
+            return length;
+        }
+
+        float getLoadFactor() const {
+            return bucket_count ? static_cast<float>(count) / bucket_count : 0.0f;
+        }
+
+        hasher getHashFunction() const {
+            return hash_function;
+        }
+
+        key_equal getKeyEqual() const {
+            return key_eq;
+        }
+
+        float getMaxLoadFactor() const {
+            return max_load_factor;
+        }
+
+        void setMaxLoadFactor(float maxLoad) {
+            if (maxLoad <= 0.0f) throw std::invalid_argument("Max load factor has to be positive.");
+            max_load_factor = maxLoad;
+            reserve(count);
+        }
+
+        //Przebudowuje tablicę tak, by miała co najmniej newBucketCount kubełków
+        //i nie przekraczała maksymalnego współczynnika wypełnienia.
+        void rehash(size_type newBucketCount) {
+            size_type required = minimalBucketCount(count);
+            if (newBucketCount < required) newBucketCount = required;
+            if (newBucketCount < INITIAL_BUCKET_COUNT) newBucketCount = INITIAL_BUCKET_COUNT;
+            newBucketCount = BucketReduction::bucketCount(newBucketCount);
+            if (newBucketCount == bucket_count) return;
+
+            Node **oldArray = array;
+            std::uint64_t *oldOccupied = occupied;
+            size_type oldBucketCount = bucket_count;
+            array = new Node *[newBucketCount]();
+            occupied = new std::uint64_t[bitmapWords(newBucketCount)]();
+            bucket_count = newBucketCount;
+            first_used = newBucketCount;
+            for (size_t i = 0; i < oldBucketCount; i++) {
+                Node *x = oldArray[i];
+                while (x) {
+                    Node *moved = x;
+                    x = x->next;
+                    size_t index = get_index(moved->item.first);
+                    if (!array[index]) markUsed(index);
+                    moved->next = array[index];
+                    array[index] = moved;
                 }
             }
-            result = array[first_used_index].head->next;
-            return Iterator(this, first_used_index, result);
+            if (oldArray == &smallHead) {
+                smallHead = nullptr;
+                smallOccupied = 0;
+                return;
+            }
+            delete[] oldArray;
+            delete[] oldOccupied;
+        }
+
+        void reserve(size_type elements) {
+            if (elements == 0 && bucket_count == 0) return;
+            if (elements <= SMALL_MAP_SIZE && (bucket_count == 0 || inSmallMode())) return;
+            if (minimalBucketCount(elements) > bucket_count || needsShrinking(elements))
+                rehash(minimalBucketCount(elements));
+        }
+
+        iterator begin() {
+            return Iterator(this, first_used, first_used < bucket_count ? array[first_used] : nullptr);
         }
 
         iterator end() {
-            BaseNode *result = NULL;
-            size_t last_used_index = 0;
-            for (size_t i = 0; i < ARRAY_SIZE; i++) {
-                if (array[i].size != 0) last_used_index = i;
-            }
-            result = array[last_used_index].tail;
-            return Iterator(this, last_used_index, result);
+            return Iterator(this, bucket_count, nullptr);
         }
 
         const_iterator cbegin() const {
-            BaseNode *result = NULL;
-            size_t first_used_index = 0;
-            for (size_t i = 0; i < ARRAY_SIZE; i++) {
-                if (array[i].size != 0) {
-                    first_used_index = i;
-                    break;
-                }
-            }
-            result = array[first_used_index].head->next;
-            return ConstIterator(this, first_used_index, result);
+            return ConstIterator(this, first_used, first_used < bucket_count ? array[first_used] : nullptr);
         }
 
         const_iterator cend() const {
-            BaseNode *result = NULL;
-            size_t last_used_index = 0;
-            for (size_t i = 0; i < ARRAY_SIZE; i++) {
-                if (array[i].size != 0) last_used_index = i;
-            }
-            result = array[last_used_index].tail;
-            return ConstIterator(this, last_used_index, result);
+            return ConstIterator(this, bucket_count, nullptr);
         }
 
         const_iterator begin() const {
@@ -235,35 +323,226 @@ namespace aisdi {
         }
 
     protected:
-        List array[ARRAY_SIZE];
+        //Kubełek to tylko wskaźnik na pierwszy node łańcucha (nullptr - kubełek pusty)
+        Node **array;
+        //Mapa bitowa zajętych kubełków - iteracja przeskakuje 64 puste kubełki jedną instrukcją
+        std::uint64_t *occupied;
+        size_t bucket_count;
+        //Indeks pierwszego niepustego kubełka (bucket_count, gdy mapa jest pusta)
+        size_t first_used;
         size_t count;
-
+        float max_load_factor;
+        Hash hash_function;
+        KeyEqual key_eq;
+        NodePool<Node, Allocator> pool;
+        //Tryb małej mapy: array wskazuje na smallHead (jeden kubełek), occupied na smallOccupied - bez
+        //haszowania i bez tablicy kubełków. Pierwsze SMALL_MAP_SIZE nodeów pochodzi z jednego bloku slabu,
+        //dalsze z puli; przebudowa tablicy tylko przepina nodey, więc nie zmieniają one adresu.
+        Node *smallHead;
+        std::uint64_t smallOccupied;
+        NodeSlab<Node, SMALL_MAP_SIZE, Allocator> slab;
+
+        //Jedyne miejsce, w którym liczony jest skrót - wszystkie operacje idą przez tę funkcję
         size_t get_index(const key_type &key) const{
-            std::hash<KeyType> h;
-            return (h(key) % ARRAY_SIZE);
+            if (inSmallMode()) return 0;
+            return BucketReduction::index(hash_function(key), bucket_count);
+        }
+
+        bool inSmallMode() const {
+            return array == &smallHead;
+        }
+
+        void enterSmallMode() {
+            smallHead = nullptr;
+            smallOccupied = 0;
+            array = &smallHead;
+            occupied = &smallOccupied;
+            bucket_count = 1;
+            first_used = 1;
+        }
+
+        template<typename... Args>
+        Node *createNode(Args &&... args) {
+            if (!slab.isFull()) return slab.create(std::forward<Args>(args)...);
+            return pool.create(std::forward<Args>(args)...);
+        }
+
+        //Tablica małej mapy jest częścią obiektu, więc zwalniamy tylko tablice z new[]
+        void releaseBuckets() {
+            if (inSmallMode()) return;
+            delete[] array;
+            delete[] occupied;
+        }
+
+        Node *findNode(const key_type &key) const {//Szuka node'a o podanym kluczu
+            if (count == 0) return nullptr;
+            return findInBucket(get_index(key), key);
+        }
+
+        Node *findInBucket(size_t index, const key_type &key) const {
+            Node *result = array[index];
+            while (result && !key_eq(result->item.first, key)) result = result->next;
+            return result;
+        }
+
+        void unlink(size_t index, Node **link) {
+            Node *removed = *link;
+            *link = removed->next;
+            if (slab.owns(removed)) slab.destroy(removed);
+            else pool.destroy(removed);
+            count--;
+            if (!array[index]) markUnused(index);
+            shrinkIfSparse();
+        }
+
+        static size_t bitmapWords(size_t buckets) {
+            return (buckets + 63) / 64;
         }
 
+        void markUsed(size_t index) {
+            occupied[index / 64] |= std::uint64_t(1) << (index % 64);
+            if (index < first_used) first_used = index;
+        }
+
+        void markUnused(size_t index) {
+            occupied[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+            if (index == first_used) first_used = nextUsedBucket(index + 1);
+        }
+
+        //Pierwszy niepusty kubełek o indeksie >= from albo bucket_count
+        size_t nextUsedBucket(size_t from) const {
+            if (from >= bucket_count) return bucket_count;
+            size_t word = from / 64;
+            std::uint64_t bits = occupied[word] & (~std::uint64_t(0) << (from % 64));
+            while (!bits) {
+                if (++word == bitmapWords(bucket_count)) return bucket_count;
+                bits = occupied[word];
+            }
+            return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+        }
+
+        //Ostatni niepusty kubełek o indeksie < before albo bucket_count, jeśli takiego nie ma
+        size_t previousUsedBucket(size_t before) const {
+            if (before == 0) return bucket_count;
+            size_t word = (before - 1) / 64;
+            size_t shift = 63 - (before - 1) % 64;
+            std::uint64_t bits = occupied[word] << shift >> shift;
+            while (!bits) {
+                if (word-- == 0) return bucket_count;
+                bits = occupied[word];
+            }
+            return word * 64 + 63 - static_cast<size_t>(__builtin_clzll(bits));
+        }
+
+        size_type minimalBucketCount(size_type elements) const {
+            return static_cast<size_type>(elements / max_load_factor) + 1;
+        }
+
+        bool needsGrowth(size_type elements) const {
+            return elements > bucket_count * max_load_factor;
+        }
+
+        //Tablicę zmniejszamy dopiero przy czterokrotnie mniejszym wypełnieniu,
+        //żeby naprzemienne wstawianie i usuwanie nie przebudowywało jej za każdym razem.
+        bool needsShrinking(size_type elements) const {
+            return bucket_count > INITIAL_BUCKET_COUNT && elements * 4 < bucket_count * max_load_factor;
+        }
+
+        void shrinkIfSparse() {
+            if (needsShrinking(count)) rehash(bucket_count / 2);
+        }
+
+        //Zostawia mapę pustą i bez kubełków po oddaniu jej pamięci innej mapie
+        void forgetStorage() {
+            array = nullptr;
+            occupied = nullptr;
+            bucket_count = 0;
+            first_used = 0;
+            count = 0;
+        }
+
+        //Przejmuje kubełki i nodey other (pula i slab są już przeniesione). Kubełek małej mapy jest
+        //częścią obiektu, więc przepinamy tylko początek łańcucha - nodey zostają na miejscu.
+        void takeStorage(HashMap &other) {
+            if (!other.inSmallMode()) {
+                array = other.array;
+                occupied = other.occupied;
+                bucket_count = other.bucket_count;
+                first_used = other.first_used;
+                count = other.count;
+                other.forgetStorage();
+                return;
+            }
+            enterSmallMode();
+            smallHead = other.smallHead;
+            smallOccupied = other.smallOccupied;
+            first_used = other.first_used;
+            count = other.count;
+            other.smallHead = nullptr;
+            other.smallOccupied = 0;
+            other.forgetStorage();
+        }
+
+        //Kopia strukturalna do pustej mapy bez kubełków: tablica ma od razu rozmiar tablicy other,
+        //a łańcuchy są przepisywane w tej samej kolejności - bez haszowania i bez przebudowy
+        //Bit kubełka i first_used ustawiamy dopiero, gdy jego łańcuch jest kompletny. Jeśli kopiowanie
+        //elementu rzuci, niszczymy już skopiowane nodey (także niedokończony łańcuch) i zostawiamy mapę pustą.
+        void copyFrom(const HashMap &other) {
+            max_load_factor = other.max_load_factor;
+            hash_function = other.hash_function;
+            key_eq = other.key_eq;
+            if (other.bucket_count == 0) return;
+            if (other.inSmallMode()) enterSmallMode();
+            else {
+                array = new Node *[other.bucket_count]();
+                occupied = new std::uint64_t[bitmapWords(other.bucket_count)]();
+                bucket_count = other.bucket_count;
+                first_used = bucket_count;
+            }
+            size_t i = other.first_used;
+            try {
+                for (; i < bucket_count; i = other.nextUsedBucket(i + 1)) {
+                    Node **tail = &array[i];
+                    for (Node *x = other.array[i]; x; x = x->next) {
+                        *tail = createNode(nullptr, x->item);
+                        tail = &(*tail)->next;
+                        ++count;
+                    }
+                    markUsed(i);
+                }
+            } catch (...) {
+                if (i < bucket_count && array[i] != nullptr) markUsed(i);
+                clean(*this);
+                releaseBuckets();
+                forgetStorage();
+                throw;
+            }
+        }
+
+        //Nodey żyją w puli mapy i w slabie, więc zamiast usuwać je pojedynczo oddajemy całe bloki naraz -
+        //O(liczba bloków). Destruktory elementów wywołujemy tylko, gdy są nietrywialne, i tylko w niepustych
+        //kubełkach wskazanych przez mapę bitową. Kubełków ani mapy bitowej nie zerujemy: każdy wołający
+        //zaraz potem je zwalnia (releaseBuckets) i zapomina (forgetStorage).
         void clean(HashMap &target) {
-            for (size_t i = 0; i < ARRAY_SIZE; i++) {
-                if(target.array[i].size != 0){
-                    BaseNode *x = target.array[i].head->next;
-                    BaseNode *to_remove;
-                    while(x != target.array[i].tail){
-                        to_remove = x;
-                        x = to_remove->next;
-                        delete to_remove;
+            if (!std::is_trivially_destructible<value_type>::value) {
+                for (size_t i = target.first_used; i < target.bucket_count; i = target.nextUsedBucket(i + 1)) {
+                    for (Node *x = target.array[i]; x;) {
+                        Node *to_remove = x;
+                        x = x->next;
+                        target.pool.forget(to_remove);
                     }
                 }
-                target.array[i].head->next = target.array[i].tail;
-                target.array[i].tail->previous = target.array[i].head;
             }
+            target.pool.release();
+            target.slab.release();
             target.count = 0;
         }
 
     };
 
-    template<typename KeyType, typename ValueType>
-    class HashMap<KeyType, ValueType>::ConstIterator {
+    template<typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator,
+            typename BucketReduction>
+    class HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator, BucketReduction>::ConstIterator {
     public:
         using reference = typename HashMap::const_reference;
         using iterator_category = std::bidirectional_iterator_tag;
@@ -272,125 +551,53 @@ namespace aisdi {
 
         friend class HashMap;
 
-        explicit ConstIterator(const HashMap *mmap, size_t tindex, BaseNode *tnode) :
+        explicit ConstIterator(const HashMap *mmap, size_t tindex, Node *tnode) :
                 map(mmap), index(tindex), node(tnode) {}
 
         ConstIterator(const ConstIterator &other) : ConstIterator(other.map, other.index, other.node) {}
 
         ConstIterator &operator++() {
-            if (node == map->end().node)throw std::out_of_range("Trying to increment end()");
-            if (node->next == map->array[index].tail) {
-                size_t next_index = index;
-                bool is_next = false;
-                if (index != ARRAY_SIZE - 1) {
-                    next_index++;
-                    for (; next_index < ARRAY_SIZE; ++next_index) {
-                        if (map->array[next_index].size != 0) {
-                            is_next = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (is_next == true) {
-                    index = next_index;
-                    node = map->array[index].head->next;
-                } else {
-                    node = node->next; //Powinno przejść na end().node
-                }
-            } else {
-                node = node->next;
+            if (!node)throw std::out_of_range("Trying to increment end()");
+            node = node->next;
+            if (!node) {
+                index = map->nextUsedBucket(index + 1);
+                if (index < map->bucket_count) node = map->array[index];
             }
             return *this;
         }
 
         ConstIterator operator++(int) {
-            if (node == map->end().node)throw std::out_of_range("Trying to increment end()");
             ConstIterator result(*this);
-            if (node->next == map->array[index].tail) {
-                size_t next_index = index;
-                bool is_next = false;
-                if (index != ARRAY_SIZE - 1) {
-                    next_index++;
-                    for (; next_index < ARRAY_SIZE; ++next_index) {
-                        if (map->array[next_index].size != 0) {
-                            is_next = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (is_next) {
-                    index = next_index;
-                    node = map->array[index].head->next;
-                } else {
-                    node = node->next; //Powinno przejść na end().node
-                }
-            } else {
-                node = node->next;
-            }
+            operator++();
             return result;
         }
 
         ConstIterator &operator--() {
-            if (node == map->begin().node)throw std::out_of_range("Trying to decrement begin()");
-            if (node->previous == map->array[index].head) {
-                size_t next_index = index;
-                bool is_next = false;
-                if (index != 0) {
-                    --next_index;
-                    for (; next_index >= 0; --next_index) {
-                        if (map->array[next_index].size != 0) {
-                            is_next = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (is_next) {
-                    index = next_index;
-                    node = map->array[index].head->next;
-                } else {
-                    node = node->previous; //Powinno przejść na begin().node
-                }
+            if (!node || node == map->array[index]) {
+                size_t previous_index = map->previousUsedBucket(index);
+                if (previous_index == map->bucket_count) throw std::out_of_range("Trying to decrement begin()");
+                index = previous_index;
+                node = map->array[index];
+                while (node->next) node = node->next;
             } else {
-                node = node->previous;
+                //Łańcuch jest jednokierunkowy - poprzednika szukamy od początku kubełka
+                Node *previous = map->array[index];
+                while (previous->next != node) previous = previous->next;
+                node = previous;
             }
             return *this;
         }
 
         ConstIterator operator--(int) {
-            if (node == map->begin().node)throw std::out_of_range("Trying to decrement begin()");
             ConstIterator result(*this);
-            if (node->previous == map->array[index].head) {
-                size_t next_index = index;
-                bool is_next = false;
-                if (index != 0) {
-                    --next_index;
-                    for (; next_index >= 0; --next_index) {
-                        if (map->array[next_index].size != 0) {
-                            is_next = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (is_next) {
-                    index = next_index;
-                    node = map->array[index].head->next;
-                } else {
-                    node = node->previous; //Powinno przejść na begin().node
-                }
-            } else {
-                node = node->previous;
-            }
+            operator--();
             return result;
         }
 
         reference operator*() const {
-            if (node == map->array[index].head || node == map->array[index].tail)
+            if (!node)
                 throw std::out_of_range("Trying to dereference outside of scope.");
-            else return (static_cast<Node *>(node))->item;
+            else return node->item;
         }
 
         pointer operator->() const {
@@ -408,18 +615,19 @@ namespace aisdi {
     protected:
         const HashMap *map;
         size_t index;
-        BaseNode *node;
+        Node *node;
     };
 
-    template<typename KeyType, typename ValueType>
-    class HashMap<KeyType, ValueType>::Iterator : public HashMap<KeyType, ValueType>::ConstIterator {
+    template<typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator,
+            typename BucketReduction>
+    class HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator, BucketReduction>::Iterator : public HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator, BucketReduction>::ConstIterator {
     public:
         using reference = typename HashMap::reference;
         using pointer = typename HashMap::value_type *;
 
         friend class HashMap;
 
-        explicit Iterator(const HashMap *mmap, size_t tindex, BaseNode *node) : ConstIterator(mmap, tindex, node) {}
+        explicit Iterator(const HashMap *mmap, size_t tindex, Node *node) : ConstIterator(mmap, tindex, node) {}
 
         Iterator(const ConstIterator &other)
                 : ConstIterator(other) {}
@@ -456,84 +664,15 @@ namespace aisdi {
         }
     };
 
-    template<typename KeyType, typename ValueType>
-    class HashMap<KeyType, ValueType>::List {
-        friend class HashMap;
-
-    public:
-        List() {
-            head = new BaseNode(nullptr, nullptr);
-            tail = new BaseNode(nullptr, nullptr);
-            head->next = tail;
-            tail->previous = head;
-            size = 0;
-        }
-
-        Node *find(const KeyType key) const {//Szuka node'a o podanym kluczu
-            BaseNode *result;
-            result = head;
-            while (result != tail) {
-                if (static_cast<Node *>(result)->item.first == key) {
-                    return static_cast<Node *>(result);
-                };
-                result = result->next;
-            }
-            return NULL;
-        }
-
-        void append(const KeyType &key, const ValueType &item) {
-            BaseNode *newNode = new Node(tail->previous, tail, key, item);
-            tail->previous->next = newNode;
-            tail->previous = newNode;
-            size++;
-        }
-
-    protected:
-        BaseNode *head;
-        BaseNode *tail;
-        size_type size;
-    };
-
-    template<typename KeyType, typename ValueType>
-    struct HashMap<KeyType, ValueType>::BaseNode {
-        BaseNode *next;
-        BaseNode *previous;
-
-        BaseNode() {
-            next = nullptr;
-            previous = nullptr;
-        }
-
-        BaseNode(BaseNode *prev, BaseNode *nxt) {
-            previous = prev;
-            next = nxt;
-        }
-
-        virtual ~BaseNode() {
-            previous = nullptr;
-            next = nullptr;
-        }
-    };
-
-    template<typename KeyType, typename ValueType>
-    struct HashMap<KeyType, ValueType>::Node : public HashMap<KeyType, ValueType>::BaseNode {
+    //Node bez sentynela i bez wirtualnego destruktora - jeden wskaźnik narzutu na element
+    template<typename KeyType, typename ValueType, typename Hash, typename KeyEqual, typename Allocator,
+            typename BucketReduction>
+    struct HashMap<KeyType, ValueType, Hash, KeyEqual, Allocator, BucketReduction>::Node {
+        Node *next;
         std::pair<const KeyType, ValueType> item;
 
-        Node() : BaseNode() {
-            item.first = nullptr;
-            item.second = nullptr;
-        }
-
-        Node(BaseNode *prev, BaseNode *nxt, const KeyType &key, const ValueType &value) : BaseNode(prev, nxt),
-                                                                                          item(key, value) {
-        }
-
-        Node(BaseNode *prev, BaseNode *nxt, KeyType &&key, ValueType &&value) : BaseNode(prev, nxt) {
-            item.first = std::move(key);
-            item = std::move(value);
-        }
-
-        ~Node() {}
+        template<typename... Args>
+        Node(Node *nxt, Args &&... args) : next(nxt), item(std::forward<Args>(args)...) {}
     };
 }
 
@@ -0,0 +1,129 @@
+#ifndef AISDI_MAPS_HASHING_H
+#define AISDI_MAPS_HASHING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <type_traits>
+
+namespace aisdi {
+
+    namespace hashing {
+
+        //Finalizator splitmix64 - każdy bit wejścia wpływa na wszystkie bity wyniku. std::hash dla liczb
+        //całkowitych to identyczność, więc bez tego klucze z wyzerowanymi młodszymi bitami trafiają do jednego kubełka.
+        inline std::uint64_t mix(std::uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ull;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBull;
+            x ^= x >> 31;
+            return x;
+        }
+
+        //Kolejne ziarno dla nowej mapy: losowa baza raz na proces, dalej licznik - bez sięgania
+        //do std::random_device przy każdym konstruktorze
+        inline std::uint64_t nextSeed() {
+            static const std::uint64_t base = (static_cast<std::uint64_t>(std::random_device{}()) << 32)
+                                              ^ std::random_device{}();
+            static std::atomic<std::uint64_t> counter(0);
+            return mix(base + counter.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed));
+        }
+    }
+
+    //Domyślna funkcja skrótu map: wynik BaseHash mieszany z ziarnem losowanym osobno dla każdej mapy
+    //(kopia mapy dziedziczy ziarno razem z układem kubełków)
+    template<typename KeyType, typename BaseHash = std::hash<KeyType>>
+    class SeededHash {
+    public:
+        SeededHash() : seed(hashing::nextSeed()) {}
+
+        explicit SeededHash(std::uint64_t tseed, const BaseHash &tbase = BaseHash()) : base(tbase), seed(tseed) {}
+
+        std::size_t operator()(const KeyType &key) const {
+            return static_cast<std::size_t>(hashing::mix(static_cast<std::uint64_t>(base(key)) ^ seed));
+        }
+
+        std::uint64_t getSeed() const {
+            return seed;
+        }
+
+    private:
+        BaseHash base;
+        std::uint64_t seed;
+    };
+
+    namespace hashing {
+
+        //Sposoby sprowadzania skrótu do numeru kubełka, wybierane parametrem szablonu mapy.
+        //bucketCount zaokrągla żądaną liczbę kubełków do rozmiaru obsługiwanego przez daną metodę.
+
+        //Reszta z dzielenia - dowolna liczba kubełków, ale dzielenie 64-bitowe na każdym wyszukiwaniu
+        struct ModuloReduction {
+            static std::size_t bucketCount(std::size_t requested) {
+                return requested;
+            }
+
+            static std::size_t index(std::size_t hash, std::size_t buckets) {
+                return hash % buckets;
+            }
+        };
+
+        //Potęga dwójki: numer kubełka to młodsze bity skrótu, hash & (buckets - 1) - jedno AND.
+        //Domyślny SeededHash już miesza skrót; własny Hash o słabych młodszych bitach zapcha kilka kubełków.
+        struct PowerOfTwoReduction {
+            static std::size_t bucketCount(std::size_t requested) {
+                std::size_t buckets = 1;
+                while (buckets < requested) buckets <<= 1;
+                return buckets;
+            }
+
+            static std::size_t index(std::size_t hash, std::size_t buckets) {
+                return hash & (buckets - 1);
+            }
+        };
+
+        //Mnożenie i przesunięcie (fastrange): starsze 64 bity iloczynu hash * buckets to liczba
+        //z [0, buckets) - dowolna liczba kubełków bez dzielenia. Wymaga dobrze wymieszanych starszych bitów.
+        struct FastRangeReduction {
+            static std::size_t bucketCount(std::size_t requested) {
+                return requested;
+            }
+
+            static std::size_t index(std::size_t hash, std::size_t buckets) {
+                return static_cast<std::size_t>(mulHigh(hash, buckets));
+            }
+
+        private:
+            static std::uint64_t mulHigh(std::uint64_t a, std::uint64_t b) {
+#ifdef __SIZEOF_INT128__
+                __extension__ typedef unsigned __int128 uint128;
+                return static_cast<std::uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#else
+                const std::uint64_t aLow = a & 0xFFFFFFFFull, aHigh = a >> 32;
+                const std::uint64_t bLow = b & 0xFFFFFFFFull, bHigh = b >> 32;
+                const std::uint64_t lowLow = aLow * bLow;
+                const std::uint64_t highLow = aHigh * bLow + (lowLow >> 32);
+                const std::uint64_t lowHigh = aLow * bHigh + (highLow & 0xFFFFFFFFull);
+                return aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32);
+#endif
+            }
+        };
+
+        //Czy dwa obiekty funkcji skrótu liczą to samo - wtedy równe klucze lądują w kubełkach o tym samym
+        //numerze. Bezstanowe funkcje są zawsze zgodne, o stanowych nic nie wiemy.
+        template<typename Hash>
+        bool sameFunction(const Hash &, const Hash &) {
+            return std::is_empty<Hash>::value;
+        }
+
+        template<typename KeyType, typename BaseHash>
+        bool sameFunction(const SeededHash<KeyType, BaseHash> &a, const SeededHash<KeyType, BaseHash> &b) {
+            return std::is_empty<BaseHash>::value && a.getSeed() == b.getSeed();
+        }
+    }
+}
+
+#endif /* AISDI_MAPS_HASHING_H */
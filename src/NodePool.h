@@ -0,0 +1,208 @@
+#ifndef AISDI_MAPS_NODEPOOL_H
+#define AISDI_MAPS_NODEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi {
+
+    //Pula nodeów jednej mapy: nodey są wycinane z bloków po ChunkSize sztuk, a zwolnione
+    //miejsca trafiają na listę wolnych i są używane ponownie przed sięgnięciem po nowy blok.
+    //Bloki pochodzą z podanego alokatora (przepiętego na typ bloku).
+    template<typename NodeType, typename Allocator = std::allocator<NodeType>, std::size_t ChunkSize = 32>
+    class NodePool {
+    public:
+        using size_type = std::size_t;
+
+        explicit NodePool(const Allocator &alloc = Allocator()) :
+                allocator(alloc), chunks(nullptr), freeList(nullptr), used(ChunkSize), chunkCount(0) {}
+
+        NodePool(const NodePool &) = delete;
+
+        NodePool &operator=(const NodePool &) = delete;
+
+        NodePool(NodePool &&other) : NodePool(other.allocator) {
+            swap(other);
+        }
+
+        ~NodePool() {
+            release();
+        }
+
+        template<typename... Args>
+        NodeType *create(Args &&... args) {
+            Slot *slot = acquire();
+            try {
+                return new(&slot->storage) NodeType(std::forward<Args>(args)...);
+            } catch (...) {
+                slot->nextFree = freeList;
+                freeList = slot;
+                throw;
+            }
+        }
+
+        void destroy(NodeType *node) {
+            node->~NodeType();
+            Slot *slot = reinterpret_cast<Slot *>(node);
+            slot->nextFree = freeList;
+            freeList = slot;
+        }
+
+        //Oddaje wszystkie bloki naraz - O(liczba bloków). Nie wywołuje destruktorów nodeów,
+        //więc dla typów z nietrywialnym destruktorem trzeba je najpierw zniszczyć przez forget().
+        void release() {
+            while (chunks) {
+                Chunk *previous = chunks->previous;
+                ChunkTraits::deallocate(allocator, chunks, 1);
+                chunks = previous;
+            }
+            freeList = nullptr;
+            used = ChunkSize;
+            chunkCount = 0;
+        }
+
+        //Wywołuje tylko destruktor - pamięć zostanie oddana razem z blokiem w release()
+        static void forget(NodeType *node) {
+            node->~NodeType();
+        }
+
+        size_type getChunkCount() const {
+            return chunkCount;
+        }
+
+        void swap(NodePool &other) {
+            std::swap(allocator, other.allocator);
+            std::swap(chunks, other.chunks);
+            std::swap(freeList, other.freeList);
+            std::swap(used, other.used);
+            std::swap(chunkCount, other.chunkCount);
+        }
+
+    private:
+        union Slot {
+            Slot *nextFree;
+            typename std::aligned_storage<sizeof(NodeType), alignof(NodeType)>::type storage;
+        };
+
+        struct Chunk {
+            Chunk *previous;
+            Slot slots[ChunkSize];
+        };
+
+        using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+        using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+        ChunkAllocator allocator;
+        Chunk *chunks;
+        Slot *freeList;
+        size_type used;
+        size_type chunkCount;
+
+        Slot *acquire() {
+            if (freeList) {
+                Slot *slot = freeList;
+                freeList = slot->nextFree;
+                return slot;
+            }
+            if (used == ChunkSize) {
+                Chunk *chunk = ChunkTraits::allocate(allocator, 1);
+                chunk->previous = chunks;
+                chunks = chunk;
+                used = 0;
+                ++chunkCount;
+            }
+            return &chunks->slots[used++];
+        }
+    };
+
+    //Pierwsze Count nodeów mapy w jednym małym bloku, alokowanym przy pierwszym create - mała mapa
+    //płaci jedną alokację zamiast bloku puli. Nodey nigdy nie zmieniają adresu (także przy przeniesieniu
+    //mapy, które przejmuje cały blok). Zajęte miejsca to bity w jednym słowie; zwolnione miejsce
+    //jest zajmowane ponownie jako pierwsze. Blok celowo nie jest częścią obiektu mapy: przeniesienie mapy
+    //albo przejście do puli zmieniałoby wtedy adresy nodeów i unieważniało referencje oraz iteratory.
+    template<typename NodeType, std::size_t Count, typename Allocator = std::allocator<NodeType>>
+    class NodeSlab {
+        static_assert(Count > 0 && Count <= 32, "Node slab holds between 1 and 32 nodes");
+
+    public:
+        using size_type = std::size_t;
+
+        explicit NodeSlab(const Allocator &alloc = Allocator()) : allocator(alloc), block(nullptr), used(0) {}
+
+        NodeSlab(const NodeSlab &) = delete;
+
+        NodeSlab &operator=(const NodeSlab &) = delete;
+
+        NodeSlab(NodeSlab &&other) : NodeSlab(other.allocator) {
+            swap(other);
+        }
+
+        ~NodeSlab() {
+            release();
+        }
+
+        //Wolne miejsce musi istnieć - sprawdza to wołający przez isFull()
+        template<typename... Args>
+        NodeType *create(Args &&... args) {
+            if (!block) block = BlockTraits::allocate(allocator, 1);
+            unsigned index = static_cast<unsigned>(__builtin_ctz(~used));
+            NodeType *node = new(&block->slots[index]) NodeType(std::forward<Args>(args)...);
+            used |= std::uint32_t(1) << index;
+            return node;
+        }
+
+        void destroy(NodeType *node) {
+            size_type index = static_cast<size_type>(reinterpret_cast<Slot *>(node) - &block->slots[0]);
+            node->~NodeType();
+            used &= ~(std::uint32_t(1) << index);
+        }
+
+        //Oddaje blok bez wywoływania destruktorów (jak NodePool::release)
+        void release() {
+            if (block) BlockTraits::deallocate(allocator, block, 1);
+            block = nullptr;
+            used = 0;
+        }
+
+        bool owns(const NodeType *node) const {
+            if (!block) return false;
+            const unsigned char *address = reinterpret_cast<const unsigned char *>(node);
+            const unsigned char *first = reinterpret_cast<const unsigned char *>(&block->slots[0]);
+            return !std::less<const unsigned char *>()(address, first)
+                   && std::less<const unsigned char *>()(address, first + sizeof(block->slots));
+        }
+
+        bool isFull() const {
+            return used == FULL;
+        }
+
+        void swap(NodeSlab &other) {
+            std::swap(allocator, other.allocator);
+            std::swap(block, other.block);
+            std::swap(used, other.used);
+        }
+
+    private:
+        using Slot = typename std::aligned_storage<sizeof(NodeType), alignof(NodeType)>::type;
+
+        struct Block {
+            Slot slots[Count];
+        };
+
+        using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+        using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+        static constexpr std::uint32_t FULL = Count == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << Count) - 1;
+
+        BlockAllocator allocator;
+        Block *block;
+        std::uint32_t used;
+    };
+}
+
+#endif /* AISDI_MAPS_NODEPOOL_H */
@@ -0,0 +1,112 @@
+#ifndef AISDI_MAPS_ROBINHOODHASHMAP_H
+#define AISDI_MAPS_ROBINHOODHASHMAP_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <tuple>
+
+#include "Hashing.h"
+#include "RobinHoodTable.h"
+
+namespace aisdi {
+
+    //Hashmapa z adresowaniem otwartym (Robin Hood) - elementy leżą bezpośrednio w płaskiej tablicy slotów,
+    //wstawianie przesuwa "bogatsze" elementy dalej, usuwanie cofa następników o jedną pozycję.
+    //Sloty na stercie, tablica podwaja się po przekroczeniu wypełnienia 7/8.
+    //Hash jak w HashMap - domyślnie SeededHash z ziarnem losowanym dla każdej mapy.
+    template<typename KeyType, typename ValueType, typename Hash = SeededHash<KeyType>>
+    class RobinHoodHashMap : public RobinHoodTable<KeyType, ValueType, Hash, robinhood::HeapStorage> {
+        using Table = RobinHoodTable<KeyType, ValueType, Hash, robinhood::HeapStorage>;
+
+    public:
+        using typename Table::key_type;
+        using typename Table::mapped_type;
+        using typename Table::value_type;
+        using typename Table::size_type;
+        using typename Table::iterator;
+        using typename Table::const_iterator;
+
+        static constexpr size_type INITIAL_CAPACITY = 16;
+        //Maksymalne wypełnienie tablicy to MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR
+        static constexpr size_type MAX_LOAD_NUMERATOR = 7;
+        static constexpr size_type MAX_LOAD_DENOMINATOR = 8;
+
+        RobinHoodHashMap() = default;
+
+        explicit RobinHoodHashMap(const Hash &hash) : Table(hash) {}
+
+        RobinHoodHashMap(std::initializer_list<value_type> list) : RobinHoodHashMap() {
+            for (auto &i: list) {
+                operator[](i.first) = i.second;
+            }
+        }
+
+        RobinHoodHashMap(const RobinHoodHashMap &other) : Table(other.hash_function) {
+            copyFrom(other);
+        }
+
+        RobinHoodHashMap(RobinHoodHashMap &&other) : Table(other.hash_function) {
+            this->storage.swap(other.storage);
+            std::swap(this->count, other.count);
+        }
+
+        RobinHoodHashMap &operator=(const RobinHoodHashMap &other) {
+            if (this == &other) return *this;
+            release();
+            this->hash_function = other.hash_function;
+            copyFrom(other);
+            return *this;
+        }
+
+        RobinHoodHashMap &operator=(RobinHoodHashMap &&other) {
+            if (this == &other) return *this;
+            release();
+            this->storage.swap(other.storage);
+            std::swap(this->count, other.count);
+            std::swap(this->hash_function, other.hash_function);
+            return *this;
+        }
+
+        mapped_type &operator[](const key_type &key) {
+            size_type index = this->findIndex(key);
+            if (index != this->slotCount()) return this->slot(index).item().second;
+            size_type capacity = this->slotCount();
+            if ((this->count + 1) * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR)
+                rehash(capacity ? capacity * 2 : INITIAL_CAPACITY);
+            return this->slot(this->insertNew(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                              std::forward_as_tuple())).item().second;
+        }
+
+        size_type getCapacity() const {
+            return this->slotCount();
+        }
+
+    protected:
+        void rehash(size_type newCapacity) {
+            typename Table::Storage oldStorage;
+            oldStorage.swap(this->storage);
+            this->storage.reset(newCapacity);
+            this->count = 0;
+            for (size_type i = 0; i < oldStorage.size(); i++) {
+                auto &old = oldStorage.data()[i];
+                if (old.isEmpty()) continue;
+                this->insertNew(old.item().first, std::move(old.item()));
+                old.destroy();
+            }
+        }
+
+        void copyFrom(const RobinHoodHashMap &other) {
+            if (other.slotCount() == 0) return;
+            this->storage.reset(other.slotCount());
+            this->copySlotsFrom(other);
+        }
+
+        void release() {
+            this->destroyItems();
+            this->storage.reset(0);
+        }
+    };
+}
+
+#endif /* AISDI_MAPS_ROBINHOODHASHMAP_H */
@@ -0,0 +1,461 @@
+#ifndef AISDI_MAPS_ROBINHOODTABLE_H
+#define AISDI_MAPS_ROBINHOODTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <type_traits>
+
+namespace aisdi {
+
+    namespace robinhood {
+
+        //Slot tablicy: distance to długość próbkowania + 1 (0 - slot pusty), element leży w surowej pamięci
+        template<typename ValueType>
+        struct Slot {
+            std::uint32_t distance;
+            typename std::aligned_storage<sizeof(ValueType), alignof(ValueType)>::type storage;
+
+            Slot() : distance(0) {}
+
+            Slot(const Slot &) = delete;
+
+            Slot &operator=(const Slot &) = delete;
+
+            bool isEmpty() const {
+                return distance == 0;
+            }
+
+            ValueType &item() {
+                return *reinterpret_cast<ValueType *>(&storage);
+            }
+
+            const ValueType &item() const {
+                return *reinterpret_cast<const ValueType *>(&storage);
+            }
+
+            template<typename... Args>
+            void construct(std::uint32_t dist, Args &&... args) {
+                new(&storage) ValueType(std::forward<Args>(args)...);
+                distance = dist;
+            }
+
+            void destroy() {
+                item().~ValueType();
+                distance = 0;
+            }
+        };
+
+        //Sloty na stercie - liczba slotów (potęga dwójki albo 0) zmienia się przy rehashu
+        struct HeapStorage {
+            template<typename SlotType>
+            class Storage {
+            public:
+                Storage() : slots(nullptr), capacity(0) {}
+
+                Storage(const Storage &) = delete;
+
+                Storage &operator=(const Storage &) = delete;
+
+                ~Storage() {
+                    delete[] slots;
+                }
+
+                SlotType *data() {
+                    return slots;
+                }
+
+                const SlotType *data() const {
+                    return slots;
+                }
+
+                std::size_t size() const {
+                    return capacity;
+                }
+
+                //Zastępuje tablicę nową, pustą - elementy starej muszą być wcześniej zniszczone lub przeniesione
+                void reset(std::size_t newCapacity) {
+                    delete[] slots;
+                    slots = newCapacity ? new SlotType[newCapacity] : nullptr;
+                    capacity = newCapacity;
+                }
+
+                void swap(Storage &other) {
+                    std::swap(slots, other.slots);
+                    std::swap(capacity, other.capacity);
+                }
+
+            private:
+                SlotType *slots;
+                std::size_t capacity;
+            };
+        };
+
+        //Sloty wewnątrz obiektu mapy - SlotCount jest stałą (potęga dwójki), więc maska składa się w czasie kompilacji
+        template<std::size_t SlotCount>
+        struct InlineStorage {
+            static_assert((SlotCount & (SlotCount - 1)) == 0, "Slot count must be a power of two");
+
+            template<typename SlotType>
+            class Storage {
+            public:
+                SlotType *data() {
+                    return slots.data();
+                }
+
+                const SlotType *data() const {
+                    return slots.data();
+                }
+
+                static constexpr std::size_t size() {
+                    return SlotCount;
+                }
+
+            private:
+                std::array<SlotType, SlotCount> slots;
+            };
+        };
+    }
+
+    //Wspólny rdzeń map Robin Hood: wyszukiwanie, wstawianie z przesuwaniem bogatszych, usuwanie z cofaniem
+    //następników i iteratory. Skąd pochodzą sloty, decyduje StoragePolicy; kiedy rosnąć - klasa pochodna.
+    template<typename KeyType, typename ValueType, typename Hash, typename StoragePolicy>
+    class RobinHoodTable {
+    public:
+        using key_type = KeyType;
+        using mapped_type = ValueType;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using size_type = std::size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using hasher = Hash;
+
+        class ConstIterator;
+
+        class Iterator;
+
+        friend class ConstIterator;
+
+        friend class Iterator;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        const mapped_type &valueOf(const key_type &key) const {
+            size_type index = findIndex(key);
+            if (index == slotCount()) throw std::out_of_range("Trying to find nonexisting key.");
+            return slot(index).item().second;
+        }
+
+        mapped_type &valueOf(const key_type &key) {
+            size_type index = findIndex(key);
+            if (index == slotCount()) throw std::out_of_range("Trying to find nonexisting key.");
+            return slot(index).item().second;
+        }
+
+        const_iterator find(const key_type &key) const {
+            return ConstIterator(this, findIndex(key));
+        }
+
+        iterator find(const key_type &key) {
+            return Iterator(this, findIndex(key));
+        }
+
+        void remove(const key_type &key) {
+            size_type index = findIndex(key);
+            if (index == slotCount()) throw std::out_of_range("Trying to erase nonexisting element.");
+            removeAt(index);
+        }
+
+        void remove(const const_iterator &it) {
+            if (it.map != this || it.index >= slotCount()) throw std::out_of_range("Trying to erase end().");
+            removeAt(it.index);
+        }
+
+        size_type getSize() const {
+            return count;
+        }
+
+        hasher getHashFunction() const {
+            return hash_function;
+        }
+
+        bool operator==(const RobinHoodTable &other) const {
+            if (this == &other) return true;
+            if (count != other.count) return false;
+            for (size_type i = 0; i < slotCount(); i++) {
+                if (slot(i).isEmpty()) continue;
+                size_type index = other.findIndex(slot(i).item().first);
+                if (index == other.slotCount()) return false;
+                if (other.slot(index).item().second != slot(i).item().second) return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const RobinHoodTable &other) const {
+            return !(*this == other);
+        }
+
+        iterator begin() {
+            return Iterator(this, firstOccupied());
+        }
+
+        iterator end() {
+            return Iterator(this, slotCount());
+        }
+
+        const_iterator cbegin() const {
+            return ConstIterator(this, firstOccupied());
+        }
+
+        const_iterator cend() const {
+            return ConstIterator(this, slotCount());
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    protected:
+        using Slot = robinhood::Slot<value_type>;
+        using Storage = typename StoragePolicy::template Storage<Slot>;
+
+        Storage storage;
+        size_type count;
+        Hash hash_function;
+
+        RobinHoodTable() : count(0) {}
+
+        explicit RobinHoodTable(const Hash &hash) : count(0), hash_function(hash) {}
+
+        RobinHoodTable(const RobinHoodTable &) = delete;
+
+        RobinHoodTable &operator=(const RobinHoodTable &) = delete;
+
+        ~RobinHoodTable() {
+            destroyItems();
+        }
+
+        size_type slotCount() const {
+            return storage.size();
+        }
+
+        Slot &slot(size_type index) {
+            return storage.data()[index];
+        }
+
+        const Slot &slot(size_type index) const {
+            return storage.data()[index];
+        }
+
+        //Maska bierze tylko młodsze bity, więc funkcja skrótu musi mieszać wszystkie bity, jak SeededHash
+        size_type homeIndex(const key_type &key) const {
+            return static_cast<size_type>(hash_function(key)) & (slotCount() - 1);
+        }
+
+        //Zwraca indeks slotu z kluczem albo slotCount(), jeśli klucza nie ma
+        size_type findIndex(const key_type &key) const {
+            if (count == 0) return slotCount();
+            size_type mask = slotCount() - 1;
+            size_type index = homeIndex(key);
+            //distance w slocie to długość próbkowania + 1, więc pusty slot (0) zawsze kończy szukanie
+            for (std::uint32_t distance = 1; distance <= slot(index).distance; ++distance) {
+                if (slot(index).item().first == key) return index;
+                index = (index + 1) & mask;
+            }
+            return slotCount();
+        }
+
+        //Wstawia nieobecny klucz, przesuwając dalej elementy bliższe swoim kubełkom; wolny slot musi istnieć
+        template<typename... Args>
+        size_type insertNew(const key_type &key, Args &&... args) {
+            size_type mask = slotCount() - 1;
+            size_type index = homeIndex(key);
+            std::uint32_t distance = 1;
+            while (slot(index).distance >= distance) {
+                index = (index + 1) & mask;
+                ++distance;
+            }
+            if (!slot(index).isEmpty()) shiftUp(index);
+            slot(index).construct(distance, std::forward<Args>(args)...);
+            ++count;
+            return index;
+        }
+
+        //Przesuwa ciąg zajętych slotów zaczynający się w start o jedną pozycję w prawo
+        void shiftUp(size_type start) {
+            size_type mask = slotCount() - 1;
+            size_type last = start;
+            while (!slot(last).isEmpty()) last = (last + 1) & mask;
+            while (last != start) {
+                size_type previous = (last - 1) & mask;
+                slot(last).construct(slot(previous).distance + 1, std::move(slot(previous).item()));
+                slot(previous).destroy();
+                last = previous;
+            }
+        }
+
+        //Usuwanie z przesunięciem wstecz - nie zostawia nagrobków
+        void removeAt(size_type index) {
+            size_type mask = slotCount() - 1;
+            slot(index).destroy();
+            size_type next = (index + 1) & mask;
+            while (slot(next).distance > 1) {
+                slot(index).construct(slot(next).distance - 1, std::move(slot(next).item()));
+                slot(next).destroy();
+                index = next;
+                next = (next + 1) & mask;
+            }
+            --count;
+        }
+
+        //Kopiuje sloty jeden do jednego - ta sama funkcja skrótu i liczba slotów dają identyczny układ,
+        //więc nie trzeba haszować. Sloty docelowe muszą być puste, a ich liczba równa liczbie slotów other.
+        void copySlotsFrom(const RobinHoodTable &other) {
+            for (size_type i = 0; i < slotCount(); i++) {
+                if (!other.slot(i).isEmpty()) slot(i).construct(other.slot(i).distance, other.slot(i).item());
+            }
+            count = other.count;
+        }
+
+        void destroyItems() {
+            if (!std::is_trivially_destructible<value_type>::value) {
+                for (size_type i = 0; i < slotCount(); i++) {
+                    if (!slot(i).isEmpty()) slot(i).destroy();
+                }
+            } else {
+                for (size_type i = 0; i < slotCount(); i++) slot(i).distance = 0;
+            }
+            count = 0;
+        }
+
+        size_type firstOccupied() const {
+            size_type index = 0;
+            while (index < slotCount() && slot(index).isEmpty()) ++index;
+            return index;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, typename Hash, typename StoragePolicy>
+    class RobinHoodTable<KeyType, ValueType, Hash, StoragePolicy>::ConstIterator {
+    public:
+        using reference = typename RobinHoodTable::const_reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename RobinHoodTable::value_type;
+        using pointer = const typename RobinHoodTable::value_type *;
+
+        friend class RobinHoodTable;
+
+        explicit ConstIterator(const RobinHoodTable *mmap, size_type tindex) : map(mmap), index(tindex) {}
+
+        ConstIterator(const ConstIterator &other) : ConstIterator(other.map, other.index) {}
+
+        ConstIterator &operator++() {
+            if (index >= map->slotCount()) throw std::out_of_range("Trying to increment end()");
+            ++index;
+            while (index < map->slotCount() && map->slot(index).isEmpty()) ++index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result(*this);
+            operator++();
+            return result;
+        }
+
+        ConstIterator &operator--() {
+            size_type previous = index;
+            while (previous > 0 && map->slot(previous - 1).isEmpty()) --previous;
+            if (previous == 0) throw std::out_of_range("Trying to decrement begin()");
+            index = previous - 1;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result(*this);
+            operator--();
+            return result;
+        }
+
+        reference operator*() const {
+            if (index >= map->slotCount()) throw std::out_of_range("Trying to dereference end().");
+            return map->slot(index).item();
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        bool operator==(const ConstIterator &other) const {
+            return this->map == other.map && this->index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const {
+            return !(*this == other);
+        }
+
+    protected:
+        const RobinHoodTable *map;
+        size_type index;
+    };
+
+    template<typename KeyType, typename ValueType, typename Hash, typename StoragePolicy>
+    class RobinHoodTable<KeyType, ValueType, Hash, StoragePolicy>::Iterator
+            : public RobinHoodTable<KeyType, ValueType, Hash, StoragePolicy>::ConstIterator {
+    public:
+        using reference = typename RobinHoodTable::reference;
+        using pointer = typename RobinHoodTable::value_type *;
+
+        friend class RobinHoodTable;
+
+        explicit Iterator(const RobinHoodTable *mmap, size_type tindex) : ConstIterator(mmap, tindex) {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other) {}
+
+        Iterator &operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+}
+
+#endif /* AISDI_MAPS_ROBINHOODTABLE_H */
@@ -0,0 +1,526 @@
+#ifndef AISDI_MAPS_SWISSHASHMAP_H
+#define AISDI_MAPS_SWISSHASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <functional>
+#include <tuple>
+
+#include "Hashing.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace aisdi {
+
+    //Bajty kontrolne: zajęty slot przechowuje 7 młodszych bitów skrótu (0..127),
+    //wolne i usunięte sloty mają ustawiony najstarszy bit.
+    namespace swiss {
+        using ctrl_t = std::int8_t;
+
+        static const ctrl_t EMPTY = -128;
+        static const ctrl_t DELETED = -2;
+        static const std::size_t GROUP_WIDTH = 16;
+
+        inline bool isFull(ctrl_t c) {
+            return c >= 0;
+        }
+
+        //Przenośna grupa - porównuje 16 bajtów kontrolnych w pętli
+        struct ScalarGroup {
+            explicit ScalarGroup(const ctrl_t *pos) {
+                std::memcpy(ctrl, pos, GROUP_WIDTH);
+            }
+
+            std::uint32_t match(ctrl_t tag) const {
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < GROUP_WIDTH; i++)
+                    if (ctrl[i] == tag) mask |= 1u << i;
+                return mask;
+            }
+
+            std::uint32_t matchEmpty() const {
+                return match(EMPTY);
+            }
+
+            std::uint32_t matchFull() const {
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < GROUP_WIDTH; i++)
+                    if (isFull(ctrl[i])) mask |= 1u << i;
+                return mask;
+            }
+
+            ctrl_t ctrl[GROUP_WIDTH];
+        };
+
+#if defined(__SSE2__)
+        //Grupa SSE2 - jedno porównanie i movemask dla 16 slotów naraz
+        struct SseGroup {
+            explicit SseGroup(const ctrl_t *pos) :
+                    ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+            std::uint32_t match(ctrl_t tag) const {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl)));
+            }
+
+            std::uint32_t matchEmpty() const {
+                return match(EMPTY);
+            }
+
+            std::uint32_t matchFull() const {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)) ^ 0xFFFFu;
+            }
+
+            __m128i ctrl;
+        };
+
+        using DefaultGroup = SseGroup;
+#else
+        using DefaultGroup = ScalarGroup;
+#endif
+
+        inline unsigned lowestBit(std::uint32_t mask) {
+            return static_cast<unsigned>(__builtin_ctz(mask));
+        }
+    }
+
+    //Hashmapa w stylu "swiss table": równoległa tablica jednobajtowych znaczników pozwala
+    //odrzucić 16 slotów jednym porównaniem, zanim porównamy jakikolwiek klucz.
+    //Hash jak w HashMap - domyślnie SeededHash z ziarnem losowanym dla każdej mapy.
+    template<typename KeyType, typename ValueType, typename Group = swiss::DefaultGroup,
+            typename Hash = SeededHash<KeyType>>
+    class SwissHashMap {
+    public:
+        using key_type = KeyType;
+        using mapped_type = ValueType;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using size_type = std::size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using hasher = Hash;
+
+        class ConstIterator;
+
+        class Iterator;
+
+        friend class ConstIterator;
+
+        friend class Iterator;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        static constexpr size_type INITIAL_CAPACITY = swiss::GROUP_WIDTH;
+
+        SwissHashMap() : ctrl(nullptr), slots(nullptr), capacity(0), count(0), deleted(0) {}
+
+        explicit SwissHashMap(const Hash &hash) : SwissHashMap() {
+            hash_function = hash;
+        }
+
+        SwissHashMap(std::initializer_list<value_type> list) : SwissHashMap() {
+            for (auto &i: list) {
+                operator[](i.first) = i.second;
+            }
+        }
+
+        SwissHashMap(const SwissHashMap &other) : SwissHashMap() {
+            copyFrom(other);
+        }
+
+        SwissHashMap(SwissHashMap &&other) : SwissHashMap() {
+            swap(other);
+        }
+
+        ~SwissHashMap() {
+            release();
+        }
+
+        SwissHashMap &operator=(const SwissHashMap &other) {
+            if (this == &other) return *this;
+            release();
+            copyFrom(other);
+            return *this;
+        }
+
+        SwissHashMap &operator=(SwissHashMap &&other) {
+            if (this == &other) return *this;
+            release();
+            swap(other);
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        mapped_type &operator[](const key_type &key) {
+            size_type hash = hashOf(key);
+            size_type index = findIndex(key, hash);
+            if (index != capacity) return slot(index).second;
+            if ((count + deleted + 1) * 8 > capacity * 7) {
+                //Dużo nagrobków przy niskim wypełnieniu - wystarczy przebudować tablicę w miejscu
+                rehash(count * 2 >= capacity ? (capacity ? capacity * 2 : INITIAL_CAPACITY) : capacity);
+            }
+            index = insertNew(hash, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+            return slot(index).second;
+        }
+
+        const mapped_type &valueOf(const key_type &key) const {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to find nonexisting key.");
+            return slot(index).second;
+        }
+
+        mapped_type &valueOf(const key_type &key) {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to find nonexisting key.");
+            return slot(index).second;
+        }
+
+        const_iterator find(const key_type &key) const {
+            return ConstIterator(this, findIndex(key, hashOf(key)));
+        }
+
+        iterator find(const key_type &key) {
+            return Iterator(this, findIndex(key, hashOf(key)));
+        }
+
+        void remove(const key_type &key) {
+            size_type index = findIndex(key, hashOf(key));
+            if (index == capacity) throw std::out_of_range("Trying to erase nonexisting element.");
+            removeAt(index);
+        }
+
+        void remove(const const_iterator &it) {
+            if (it.map != this || it.index >= capacity) throw std::out_of_range("Trying to erase end().");
+            removeAt(it.index);
+        }
+
+        size_type getSize() const {
+            return count;
+        }
+
+        size_type getCapacity() const {
+            return capacity;
+        }
+
+        hasher getHashFunction() const {
+            return hash_function;
+        }
+
+        bool operator==(const SwissHashMap &other) const {
+            if (this == &other) return true;
+            if (count != other.count) return false;
+            for (size_type i = 0; i < capacity; i++) {
+                if (!swiss::isFull(ctrl[i])) continue;
+                const value_type &item = slot(i);
+                size_type index = other.findIndex(item.first, other.hashOf(item.first));
+                if (index == other.capacity) return false;
+                if (other.slot(index).second != item.second) return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const SwissHashMap &other) const {
+            return !(*this == other);
+        }
+
+        iterator begin() {
+            return Iterator(this, nextFull(0));
+        }
+
+        iterator end() {
+            return Iterator(this, capacity);
+        }
+
+        const_iterator cbegin() const {
+            return ConstIterator(this, nextFull(0));
+        }
+
+        const_iterator cend() const {
+            return ConstIterator(this, capacity);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    protected:
+        using Storage = typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type;
+
+        swiss::ctrl_t *ctrl;
+        Storage *slots;
+        size_type capacity;
+        size_type count;
+        size_type deleted;
+        Hash hash_function;
+
+        value_type &slot(size_type index) {
+            return *reinterpret_cast<value_type *>(&slots[index]);
+        }
+
+        const value_type &slot(size_type index) const {
+            return *reinterpret_cast<const value_type *>(&slots[index]);
+        }
+
+        //Skrót dzielimy na h1 (starsze bity - grupa) i h2 (7 młodszych - znacznik), więc funkcja skrótu
+        //musi mieszać wszystkie bity, jak SeededHash
+        size_type hashOf(const key_type &key) const {
+            return static_cast<size_type>(hash_function(key));
+        }
+
+        static swiss::ctrl_t tagOf(size_type hash) {
+            return static_cast<swiss::ctrl_t>(hash & 0x7F);
+        }
+
+        //Pierwsza grupa, od której zaczyna się sondowanie (h1 to starsze bity skrótu)
+        size_type firstGroup(size_type hash) const {
+            return (hash >> 7) & (capacity / swiss::GROUP_WIDTH - 1);
+        }
+
+        size_type findIndex(const key_type &key, size_type hash) const {
+            if (count == 0) return capacity;
+            size_type groupMask = capacity / swiss::GROUP_WIDTH - 1;
+            size_type group = firstGroup(hash);
+            swiss::ctrl_t tag = tagOf(hash);
+            //Sondowanie trójkątne po grupach odwiedza każdą grupę dokładnie raz
+            for (size_type step = 1;; ++step) {
+                size_type base = group * swiss::GROUP_WIDTH;
+                Group g(ctrl + base);
+                for (std::uint32_t match = g.match(tag); match; match &= match - 1) {
+                    size_type index = base + swiss::lowestBit(match);
+                    if (slot(index).first == key) return index;
+                }
+                if (g.matchEmpty() || step > groupMask) return capacity;
+                group = (group + step) & groupMask;
+            }
+        }
+
+        template<typename... Args>
+        size_type insertNew(size_type hash, Args &&... args) {
+            size_type groupMask = capacity / swiss::GROUP_WIDTH - 1;
+            size_type group = firstGroup(hash);
+            for (size_type step = 1;; ++step) {
+                size_type base = group * swiss::GROUP_WIDTH;
+                Group g(ctrl + base);
+                std::uint32_t available = g.matchFull() ^ 0xFFFFu;
+                if (available) {
+                    size_type index = base + swiss::lowestBit(available);
+                    if (ctrl[index] == swiss::DELETED) --deleted;
+                    new(&slots[index]) value_type(std::forward<Args>(args)...);
+                    ctrl[index] = tagOf(hash);
+                    ++count;
+                    return index;
+                }
+                group = (group + step) & groupMask;
+            }
+        }
+
+        void removeAt(size_type index) {
+            slot(index).~value_type();
+            //Grupa, która wciąż ma wolny slot, nigdy nie była pełna, więc żadne sondowanie
+            //nie przechodzi przez nią dalej - można od razu oznaczyć slot jako wolny
+            Group g(ctrl + index / swiss::GROUP_WIDTH * swiss::GROUP_WIDTH);
+            if (g.matchEmpty()) {
+                ctrl[index] = swiss::EMPTY;
+            } else {
+                ctrl[index] = swiss::DELETED;
+                ++deleted;
+            }
+            --count;
+        }
+
+        void allocate(size_type newCapacity) {
+            ctrl = new swiss::ctrl_t[newCapacity];
+            std::memset(ctrl, static_cast<unsigned char>(swiss::EMPTY), newCapacity);
+            slots = new Storage[newCapacity];
+            capacity = newCapacity;
+            count = 0;
+            deleted = 0;
+        }
+
+        void rehash(size_type newCapacity) {
+            swiss::ctrl_t *oldCtrl = ctrl;
+            Storage *oldSlots = slots;
+            size_type oldCapacity = capacity;
+            allocate(newCapacity);
+            for (size_type i = 0; i < oldCapacity; i++) {
+                if (!swiss::isFull(oldCtrl[i])) continue;
+                value_type &item = *reinterpret_cast<value_type *>(&oldSlots[i]);
+                insertNew(hashOf(item.first), std::move(item));
+                item.~value_type();
+            }
+            delete[] oldCtrl;
+            delete[] oldSlots;
+        }
+
+        //Kopiujemy bajty kontrolne i elementy na te same pozycje - bez ponownego haszowania,
+        //więc kopia musi też przejąć funkcję skrótu
+        void copyFrom(const SwissHashMap &other) {
+            hash_function = other.hash_function;
+            if (other.capacity == 0) return;
+            allocate(other.capacity);
+            std::memcpy(ctrl, other.ctrl, capacity);
+            for (size_type i = 0; i < capacity; i++) {
+                if (swiss::isFull(ctrl[i])) new(&slots[i]) value_type(other.slot(i));
+            }
+            count = other.count;
+            deleted = other.deleted;
+        }
+
+        void release() {
+            for (size_type i = 0; i < capacity; i++) {
+                if (swiss::isFull(ctrl[i])) slot(i).~value_type();
+            }
+            delete[] ctrl;
+            delete[] slots;
+            ctrl = nullptr;
+            slots = nullptr;
+            capacity = 0;
+            count = 0;
+            deleted = 0;
+        }
+
+        void swap(SwissHashMap &other) {
+            std::swap(ctrl, other.ctrl);
+            std::swap(slots, other.slots);
+            std::swap(capacity, other.capacity);
+            std::swap(count, other.count);
+            std::swap(deleted, other.deleted);
+            std::swap(hash_function, other.hash_function);
+        }
+
+        //Szuka zajętego slotu od pozycji index, przeskakując całe puste grupy
+        size_type nextFull(size_type index) const {
+            while (index < capacity) {
+                size_type base = index / swiss::GROUP_WIDTH * swiss::GROUP_WIDTH;
+                std::uint32_t full = Group(ctrl + base).matchFull() >> (index - base) << (index - base);
+                if (full) return base + swiss::lowestBit(full);
+                index = base + swiss::GROUP_WIDTH;
+            }
+            return capacity;
+        }
+    };
+
+    template<typename KeyType, typename ValueType, typename Group, typename Hash>
+    class SwissHashMap<KeyType, ValueType, Group, Hash>::ConstIterator {
+    public:
+        using reference = typename SwissHashMap::const_reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename SwissHashMap::value_type;
+        using pointer = const typename SwissHashMap::value_type *;
+
+        friend class SwissHashMap;
+
+        explicit ConstIterator(const SwissHashMap *mmap, size_type tindex) : map(mmap), index(tindex) {}
+
+        ConstIterator(const ConstIterator &other) : ConstIterator(other.map, other.index) {}
+
+        ConstIterator &operator++() {
+            if (index >= map->capacity) throw std::out_of_range("Trying to increment end()");
+            index = map->nextFull(index + 1);
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result(*this);
+            operator++();
+            return result;
+        }
+
+        ConstIterator &operator--() {
+            size_type previous = index;
+            while (previous > 0 && !swiss::isFull(map->ctrl[previous - 1])) --previous;
+            if (previous == 0) throw std::out_of_range("Trying to decrement begin()");
+            index = previous - 1;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result(*this);
+            operator--();
+            return result;
+        }
+
+        reference operator*() const {
+            if (index >= map->capacity) throw std::out_of_range("Trying to dereference end().");
+            return map->slot(index);
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        bool operator==(const ConstIterator &other) const {
+            return this->map == other.map && this->index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const {
+            return !(*this == other);
+        }
+
+    protected:
+        const SwissHashMap *map;
+        size_type index;
+    };
+
+    template<typename KeyType, typename ValueType, typename Group, typename Hash>
+    class SwissHashMap<KeyType, ValueType, Group, Hash>::Iterator : public SwissHashMap<KeyType, ValueType, Group, Hash>::ConstIterator {
+    public:
+        using reference = typename SwissHashMap::reference;
+        using pointer = typename SwissHashMap::value_type *;
+
+        friend class SwissHashMap;
+
+        explicit Iterator(const SwissHashMap *mmap, size_type tindex) : ConstIterator(mmap, tindex) {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other) {}
+
+        Iterator &operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        pointer operator->() const {
+            return &this->operator*();
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+}
+
+#endif /* AISDI_MAPS_SWISSHASHMAP_H */
@@ -6,6 +6,13 @@
 #include <stdexcept>
 #include <utility>
 #include <iostream>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+#include "NodePool.h"
 
 namespace aisdi {
 
@@ -17,70 +24,99 @@ namespace aisdi {
         using value_type = std::pair<const key_type, mapped_type>;
         using size_type = std::size_t;
         using reference = value_type &;
+
+        //Tyle węzłów mieści się w bloku alokowanym przy pierwszym wstawieniu
+        static constexpr size_type SMALL_MAP_SIZE = 8;
         using const_reference = const value_type &;
 
 
         class ConstIterator;
         struct Node;
         class Iterator;
+        template<typename RangeIterator>
+        class RangeView;
 
         friend class ConstIterator;
         friend class Node;
 
         using iterator = Iterator;
         using const_iterator = ConstIterator;
+        using range_type = RangeView<Iterator>;
+        using const_range_type = RangeView<ConstIterator>;
 
-        TreeMap(): root(NULL), count(0) {}
+        TreeMap(): root(NULL), leftmost(NULL), rightmost(NULL), count(0) {}
         ~TreeMap(){
-            clean(root);
+            clean();
         }
 
-        TreeMap(std::initializer_list<value_type> list):TreeMap() {
-            for(auto i : list) insert(i.first, i.second);
-        }
+        TreeMap(std::initializer_list<value_type> list):TreeMap(fromUnsorted(list.begin(), list.end())) {}
 
         TreeMap(const TreeMap &other):TreeMap() {
-            for(auto i: other)insert(i.first, i.second);
+            copyFrom(other);
         }
 
         TreeMap(TreeMap &&other):TreeMap() {
-            root = other.root;
-            other.root = NULL;
-            count = other.count;
-            other.count = 0;
+            takeFrom(other);
         }
 
         TreeMap &operator=(const TreeMap &other) {
-            if(*this == other) return *this;
-            clean(root);
-            root = NULL;
-            count = 0;
-            for(auto i: other)insert(i.first, i.second);
+            if(this == &other) return *this;
+            clean();
+            copyFrom(other);
             return *this;
         }
 
         TreeMap &operator=(TreeMap &&other) {
-            if(*this == other) return *this;
-            clean(root);
-            root = other.root;
-            other.root = NULL;
-            count = other.count;
-            other.count = 0;
+            if(this == &other) return *this;
+            clean();
+            takeFrom(other);
             return *this;
         }
 
+        //Buduje drzewo w czasie O(n) z ciągu posortowanego po kluczu. Przy powtórzonych kluczach
+        //zostaje ostatni element; ciąg nieposortowany kończy się invalid_argument.
+        template<typename ForwardIt>
+        static TreeMap fromSorted(ForwardIt first, ForwardIt last) {
+            TreeMap result;
+            result.buildFromSorted(first, last);
+            return result;
+        }
+
+        //Sortuje kopię elementów (stabilnie - przy powtórzeniach wygrywa ostatni) i buduje jak fromSorted
+        template<typename InputIt>
+        static TreeMap fromUnsorted(InputIt first, InputIt last) {
+            std::vector<std::pair<key_type, mapped_type>> items(first, last);
+            std::stable_sort(items.begin(), items.end(),
+                             [](const std::pair<key_type, mapped_type> &a, const std::pair<key_type, mapped_type> &b) {
+                                 return a.first < b.first;
+                             });
+            return fromSorted(items.begin(), items.end());
+        }
+
         bool isEmpty() const {
             return !count;
         }
 
         mapped_type &operator[](const key_type &key) {
-            Node *current = findNode(key);
-            if( !current ){
-                insert(key, ValueType());
-                current = findNode(key);
-                return current->NodePair.second;
+            return tryEmplace(key).first->second;
+        }
+
+        //Jedno zejście w głąb drzewa: albo znajduje węzeł o kluczu, albo tworzy go w miejscu
+        //(wartość konstruowana z args). Zwraca iterator na węzeł i informację, czy go wstawiono.
+        template<typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&... args) {
+            Node *parent = NULL;
+            Node **link = &root;
+            while (*link) {
+                parent = *link;
+                if (key < parent->NodePair.first) link = &parent->left;
+                else if (parent->NodePair.first < key) link = &parent->right;
+                else return {Iterator(this, parent), false};
             }
-            return current->NodePair.second;
+            Node *created = createNode(std::piecewise_construct, std::forward_as_tuple(key),
+                                       std::forward_as_tuple(std::forward<Args>(args)...));
+            attachLeaf(parent, link, created);
+            return {Iterator(this, created), true};
         }
 
         const mapped_type &valueOf(const key_type &key) const {
@@ -103,36 +139,99 @@ namespace aisdi {
             return Iterator(this,findNode(key));
         }
 
-        void insert(KeyType tkey, ValueType tvalue){
-                root = insertToNode(root, tkey, tvalue);
-                count++;
-                return;
+        //Pierwszy element o kluczu nie mniejszym niż key (end(), jeśli takiego nie ma)
+        const_iterator lowerBound(const key_type &key) const {
+            return ConstIterator(this, lowerBoundNode(key));
         }
 
+        iterator lowerBound(const key_type &key) {
+            return Iterator(this, lowerBoundNode(key));
+        }
+
+        //Pierwszy element o kluczu większym niż key (end(), jeśli takiego nie ma)
+        const_iterator upperBound(const key_type &key) const {
+            return ConstIterator(this, upperBoundNode(key));
+        }
+
+        iterator upperBound(const key_type &key) {
+            return Iterator(this, upperBoundNode(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equalRange(const key_type &key) const {
+            return {lowerBound(key), upperBound(key)};
+        }
+
+        std::pair<iterator, iterator> equalRange(const key_type &key) {
+            return {lowerBound(key), upperBound(key)};
+        }
+
+        //Liczba elementów o kluczach mniejszych niż key (klucz nie musi być w mapie)
+        size_type rankOf(const key_type &key) const {
+            Node *bound = lowerBoundNode(key);
+            return bound ? rankOfNode(bound) : count;
+        }
+
+        //Element o indeksie index w porządku kluczy, liczonym od zera
+        const_iterator nth(size_type index) const {
+            return ConstIterator(this, nthNode(index));
+        }
+
+        iterator nth(size_type index) {
+            return Iterator(this, nthNode(index));
+        }
+
+        //Odpowiednik std::distance w O(log n) - last nie może poprzedzać first
+        size_type distance(const const_iterator &first, const const_iterator &last) const {
+            return rankOfIterator(last) - rankOfIterator(first);
+        }
+
+        //Elementy o kluczach z przedziału [from, to) - wyszukanie końców w O(log n),
+        //dalej zwykłe kroki iteratora. Dla to <= from widok jest pusty.
+        const_range_type range(const key_type &from, const key_type &to) const {
+            const_iterator first = lowerBound(from);
+            return const_range_type(first, from < to ? lowerBound(to) : first);
+        }
+
+        range_type range(const key_type &from, const key_type &to) {
+            iterator first = lowerBound(from);
+            return range_type(first, from < to ? lowerBound(to) : first);
+        }
+
+        //Klucze są unikalne: jeśli klucz już jest w drzewie, nadpisujemy wartość w tym samym zejściu.
+        //Zwraca iterator na element i informację, czy powstał nowy węzeł.
+        std::pair<iterator, bool> insert(const key_type &tkey, const mapped_type &tvalue){
+                std::pair<iterator, bool> result = tryEmplace(tkey, tvalue);
+                if (!result.second) result.first->second = tvalue;
+                return result;
+        }
+
+        //Jedno zejście po klucz - samo wypięcie węzła idzie już po wskaźnikach na rodzica
         void remove(const key_type &key) {
             Node *temp = findNode(key);
             if( !temp ) throw std::out_of_range("Obiekt o podanym kluczu nie istnieje.");
-            temp = removeNode(root, key);
-            root = temp;
-            count--;
+            removeNode(temp);
         }
 
-        void remove(const const_iterator &it) {
+        //Usuwa węzeł wskazywany przez iterator bez szukania go po kluczu; zwraca iterator na następnik
+        iterator remove(const const_iterator &it) {
             if(it == end())throw std::out_of_range("Trying to erase end()");
-            remove(it.currentNode->NodePair.first);
+            Node *successor = nextNode(it.currentNode);
+            removeNode(it.currentNode);
+            return Iterator(this, successor);
         }
 
         size_type getSize() const {
             return count;
         }
 
+        //Oba drzewa przechodzimy jednocześnie w porządku in-order - O(n) zamiast szukania każdego klucza
         bool operator==(const TreeMap &other) const {
-            if ((this->getSize() == 0) && (other.getSize() == 0)) return true;
+            if (this == &other) return true;
             if (this->getSize() != other.getSize()) return false;
 
-            for (auto i: other) {
-                if (!(this->findNode(i.first))) return false;
-                if (((this->findNode(i.first))->NodePair.second) != i.second) return false;
+            for (Node *a = leftmost, *b = other.leftmost; a; a = nextNode(a), b = nextNode(b)) {
+                if (a->NodePair.first < b->NodePair.first || b->NodePair.first < a->NodePair.first) return false;
+                if (a->NodePair.second != b->NodePair.second) return false;
             }
             return true;
         }
@@ -142,8 +241,7 @@ namespace aisdi {
         }
 
         iterator begin() {
-            if(count == 0) return Iterator(this, NULL);
-            return Iterator(this, findFirst(root));
+            return Iterator(this, leftmost);
         }
 
         iterator end() {
@@ -151,8 +249,7 @@ namespace aisdi {
         }
 
         const_iterator cbegin() const {
-            if(count == 0) return ConstIterator(this, NULL);
-            return ConstIterator(this, findFirst(root));
+            return ConstIterator(this, leftmost);
         }
 
         const_iterator cend() const {
@@ -167,9 +264,53 @@ namespace aisdi {
             return cend();
         }
 
+        //Element o najmniejszym i największym kluczu - bez schodzenia po drzewie
+        reference front() {
+            if (!leftmost) throw std::out_of_range("Trying to access front() of empty map.");
+            return leftmost->NodePair;
+        }
+
+        const_reference front() const {
+            if (!leftmost) throw std::out_of_range("Trying to access front() of empty map.");
+            return leftmost->NodePair;
+        }
+
+        reference back() {
+            if (!rightmost) throw std::out_of_range("Trying to access back() of empty map.");
+            return rightmost->NodePair;
+        }
+
+        const_reference back() const {
+            if (!rightmost) throw std::out_of_range("Trying to access back() of empty map.");
+            return rightmost->NodePair;
+        }
+
     protected:
         Node *root;
+        //Skrajne węzły są aktualizowane przy wstawianiu i usuwaniu; rotacje nie zmieniają porządku in-order
+        Node *leftmost;
+        Node *rightmost;
         unsigned int count;
+        NodePool<Node> pool;
+        //Pierwsze SMALL_MAP_SIZE węzłów pochodzi z jednego małego bloku, dalsze z puli. Węzły nie zmieniają
+        //adresu, gdy drzewo urośnie, więc referencje i iteratory zostają ważne.
+        NodeSlab<Node, SMALL_MAP_SIZE> slab;
+
+        //Podpinanie dzieci zawsze przez te funkcje, żeby wskaźniki na rodzica były aktualne
+        static void linkLeft(Node *pnode, Node *child){
+            pnode->left = child;
+            if (child) child->parent = pnode;
+        }
+
+        static void linkRight(Node *pnode, Node *child){
+            pnode->right = child;
+            if (child) child->parent = pnode;
+        }
+
+        void setRoot(Node *pnode){
+            root = pnode;
+            if (root) root->parent = NULL;
+        }
 
         //Funkcje pomocnicze do drzewa AVL
         unsigned char height(Node *pnode) {
@@ -180,16 +321,22 @@ namespace aisdi {
             return height(pnode->right) - height(pnode->left);
         }
 
+        static unsigned int subtreeSize(const Node *pnode) {
+            return pnode ? pnode->size : 0;
+        }
+
+        //Przelicza wysokość i rozmiar poddrzewa z dzieci - rotacje i budowanie drzewa idą przez tę funkcję
         void fixheight(Node *pnode){
             unsigned char hl = height(pnode->left);
             unsigned char hr = height(pnode->right);
             pnode->height = ((hl>hr ? hl : hr) + (unsigned char) 1);
+            pnode->size = subtreeSize(pnode->left) + subtreeSize(pnode->right) + 1;
         }
 
         Node *rotateRight(Node *pnode){
             Node *qnode = pnode->left;
-            pnode->left = qnode->right;
-            qnode->right = pnode;
+            linkLeft(pnode, qnode->right);
+            linkRight(qnode, pnode);
             fixheight(pnode);
             fixheight(qnode);
             return qnode;
@@ -197,8 +344,8 @@ namespace aisdi {
 
         Node *rotateLeft(Node *qnode){
             Node *pnode = qnode->right;
-            qnode->right = pnode->left;
-            pnode->left = qnode;
+            linkRight(qnode, pnode->left);
+            linkLeft(pnode, qnode);
             fixheight(qnode);
             fixheight(pnode);
             return pnode;
@@ -208,94 +355,282 @@ namespace aisdi {
             fixheight(pnode);
             if(bfactor(pnode) == 2){
                 if(bfactor(pnode->right) < 0)
-                    pnode->right = rotateRight(pnode->right);
+                    linkRight(pnode, rotateRight(pnode->right));
                 return rotateLeft(pnode);
             }
             if(bfactor(pnode) == -2){
                 if(bfactor(pnode->left) > 0)
-                    pnode->left = rotateLeft(pnode->left);
+                    linkLeft(pnode, rotateLeft(pnode->left));
                 return rotateRight(pnode);
             }
             return pnode;
         }
 
-        Node *insertToNode(Node *pnode, const KeyType tkey, const ValueType tvalue){
-            if (!pnode)
-                return new Node(tkey, tvalue);
-            if(tkey < pnode->NodePair.first)
-                pnode->left = insertToNode(pnode->left, tkey, tvalue);
-            else
-                pnode->right = insertToNode(pnode->right, tkey, tvalue);
-            return balance(pnode);
+        template<typename... Args>
+        Node *createNode(Args &&... args) {
+            if (!slab.isFull()) return slab.create(std::forward<Args>(args)...);
+            return pool.create(std::forward<Args>(args)...);
         }
 
-        Node *findMinNode(Node *pnode)const{
-            return pnode->left ? findMinNode(pnode->left) : pnode;
+        void releaseNode(Node *pnode) {
+            if (slab.owns(pnode)) slab.destroy(pnode);
+            else pool.destroy(pnode);
         }
 
-        Node *removeMinNode(Node *pnode){
-            if( pnode->left == NULL)
-                return pnode->right;
-            pnode->left = removeMinNode(pnode->left);
-            return balance(pnode);
+        //Kopia strukturalna do pustego drzewa: ten sam kształt i te same wysokości, bez porównań i rotacji
+        void copyFrom(const TreeMap &other) {
+            setRoot(cloneSubtree(other.root));
+            leftmost = findFirst(root);
+            rightmost = findLast(root);
+            count = other.count;
         }
 
-        Node *removeNode(Node *pnode, KeyType tkey){
-            if ( !pnode ) return NULL;
-            if( tkey < pnode->NodePair.first )
-                pnode->left = removeNode(pnode->left, tkey);
-            else if(tkey > pnode->NodePair.first )
-                pnode->right = removeNode(pnode->right, tkey);
-            else{
-                Node *qnode = pnode->left;
-                Node *rnode = pnode->right;
-                delete pnode;
-                if( !rnode ) return qnode;
-                Node *min = findMinNode(rnode);
-                min->right = removeMinNode(rnode);
-                min->left = qnode;
-                return balance(min);
-            }
-            return balance(pnode);
+        //Głębokość rekursji to wysokość drzewa AVL, czyli O(log n)
+        Node *cloneSubtree(const Node *source) {
+            if (!source) return NULL;
+            Node *pnode = createNode(source->NodePair.first, source->NodePair.second);
+            pnode->height = source->height;
+            pnode->size = source->size;
+            linkLeft(pnode, cloneSubtree(source->left));
+            linkRight(pnode, cloneSubtree(source->right));
+            return pnode;
         }
 
-        Node *findNodeAt(Node *pnode, KeyType tkey)const{
-            if( !pnode ) return NULL;
-            if(tkey < pnode->NodePair.first ) pnode = findNodeAt(pnode->left, tkey);
-            else if(tkey > pnode->NodePair.first ) pnode = findNodeAt(pnode->right, tkey);
+        //Przejmuje węzły innego drzewa razem z pulą i blokiem slabu - bez kopiowania węzłów
+        void takeFrom(TreeMap &other) {
+            pool.swap(other.pool);
+            slab.swap(other.slab);
+            root = other.root;
+            other.root = NULL;
+            leftmost = other.leftmost;
+            other.leftmost = NULL;
+            rightmost = other.rightmost;
+            other.rightmost = NULL;
+            count = other.count;
+            other.count = 0;
+        }
+
+        //Pierwsze przejście liczy różne klucze i sprawdza posortowanie, drugie buduje drzewo,
+        //w którym rozmiary poddrzew różnią się najwyżej o 1 - wysokości wynikają wprost z budowy
+        template<typename ForwardIt>
+        void buildFromSorted(ForwardIt first, ForwardIt last) {
+            size_type distinct = first != last ? 1 : 0;
+            for (ForwardIt previous = first, it = first; it != last && ++it != last; previous = it) {
+                if (it->first < previous->first)
+                    throw std::invalid_argument("Input range is not sorted by key.");
+                if (previous->first < it->first) distinct++;
+            }
+            setRoot(buildBalanced(first, last, distinct));
+            leftmost = findFirst(root);
+            rightmost = findLast(root);
+            count = distinct;
+        }
+
+        //Buduje poddrzewo z n kolejnych różnych kluczy, przesuwając first za zużyte elementy
+        template<typename ForwardIt>
+        Node *buildBalanced(ForwardIt &first, ForwardIt last, size_type n) {
+            if (n == 0) return NULL;
+            Node *left = buildBalanced(first, last, (n - 1) / 2);
+            ForwardIt item = first;
+            while (++first != last && !(item->first < first->first)) item = first;
+            Node *pnode = createNode(item->first, item->second);
+            Node *right = buildBalanced(first, last, n - 1 - (n - 1) / 2);
+            linkLeft(pnode, left);
+            linkRight(pnode, right);
+            fixheight(pnode);
             return pnode;
         }
 
-        Node *findNode(KeyType tkey)const{
-            return findNodeAt(root, tkey);
+        //Wstawia dziecko w miejsce old pod rodzicem parent (albo jako korzeń)
+        void replaceChild(Node *parent, Node *old, Node *child){
+            if (!parent) setRoot(child);
+            else if (parent->left == old) linkLeft(parent, child);
+            else linkRight(parent, child);
+        }
+
+        //Równoważenie od pnode w górę po wskaźnikach na rodzica - ścieżka do korzenia jest zapisana
+        //w samych węzłach, więc nie potrzebujemy ani rekursji, ani osobnego stosu.
+        //Kończymy, gdy poddrzewo nie zmieniło ani korzenia, ani wysokości.
+        void rebalanceUpwards(Node *pnode){
+            while (pnode) {
+                Node *parent = pnode->parent;
+                unsigned char oldHeight = pnode->height;
+                Node *subtree = balance(pnode);
+                replaceChild(parent, pnode, subtree);
+                if (subtree == pnode && pnode->height == oldHeight) return;
+                pnode = parent;
+            }
         }
 
-        //Zakładamy przechodzenie po drzewie in-order(Left->Parent->Right)
-        Node *findLast() const{
-            Node *last = NULL;
-            TraverseInOrder(root, last);
-            return last;
+        void attachLeaf(Node *parent, Node **link, Node *leaf){
+            *link = leaf;
+            leaf->parent = parent;
+            count++;
+            if (!leftmost || (parent == leftmost && link == &parent->left)) leftmost = leaf;
+            if (!rightmost || (parent == rightmost && link == &parent->right)) rightmost = leaf;
+            for (Node *p = parent; p; p = p->parent) p->size++;
+            rebalanceUpwards(parent);
+        }
+
+        //Wypina węzeł z drzewa (węzeł z dwójką dzieci zastępujemy jego następnikiem) i go usuwa
+        void removeNode(Node *pnode){
+            if (pnode == leftmost) leftmost = nextNode(pnode);
+            if (pnode == rightmost) rightmost = previousNode(pnode);
+            Node *retraceFrom;
+            if (!pnode->left || !pnode->right) {
+                retraceFrom = pnode->parent;
+                replaceChild(pnode->parent, pnode, pnode->left ? pnode->left : pnode->right);
+            } else {
+                Node *successor = findFirst(pnode->right);
+                if (successor->parent == pnode) {
+                    retraceFrom = successor;
+                } else {
+                    retraceFrom = successor->parent;
+                    linkLeft(successor->parent, successor->right);
+                    linkRight(successor, pnode->right);
+                }
+                linkLeft(successor, pnode->left);
+                successor->height = pnode->height;
+                successor->size = pnode->size;
+                replaceChild(pnode->parent, pnode, successor);
+            }
+            releaseNode(pnode);
+            count--;
+            //Następnik stoi już na miejscu usuniętego węzła, więc też jest na tej ścieżce
+            for (Node *p = retraceFrom; p; p = p->parent) p->size--;
+            rebalanceUpwards(retraceFrom);
         }
-        Node *findFirst(Node *pnode) const{
-            return pnode->left ? findFirst(pnode->left) : pnode;
+
+        //Liczba elementów przed węzłem - rozmiary lewych poddrzew zbierane w drodze do korzenia
+        static size_type rankOfNode(const Node *pnode) {
+            size_type rank = subtreeSize(pnode->left);
+            for (const Node *p = pnode->parent; p; pnode = p, p = p->parent)
+                if (pnode == p->right) rank += subtreeSize(p->left) + 1;
+            return rank;
         }
 
-        //Funkcja przechodząca po drzewie in-order(Left->Parent->Right)
-        void TraverseInOrder(Node *p, Node* &t)const{
-            if ( !p ) return;
-            TraverseInOrder(p->left, t);
-            t = p;
-            TraverseInOrder(p->right, t);
+        size_type rankOfIterator(const const_iterator &it) const {
+            return it.currentNode ? rankOfNode(it.currentNode) : count;
         }
 
-        void clean(Node *p){
-            if ( !p ) return;
-            clean(p->left);
-            clean(p->right);
-            delete p;
+        Node *nthNode(size_type index) const {
+            if (index >= count) throw std::out_of_range("Index out of range.");
+            Node *pnode = root;
+            while (true) {
+                size_type leftSize = subtreeSize(pnode->left);
+                if (index < leftSize) pnode = pnode->left;
+                else if (index == leftSize) return pnode;
+                else {
+                    index -= leftSize + 1;
+                    pnode = pnode->right;
+                }
+            }
+        }
+
+        Node *lowerBoundNode(const key_type &tkey) const {
+            Node *result = NULL;
+            for (Node *pnode = root; pnode;) {
+                if (pnode->NodePair.first < tkey) pnode = pnode->right;
+                else {
+                    result = pnode;
+                    pnode = pnode->left;
+                }
+            }
+            return result;
+        }
+
+        Node *upperBoundNode(const key_type &tkey) const {
+            Node *result = NULL;
+            for (Node *pnode = root; pnode;) {
+                if (tkey < pnode->NodePair.first) {
+                    result = pnode;
+                    pnode = pnode->left;
+                } else pnode = pnode->right;
+            }
+            return result;
+        }
+
+        Node *findNode(const key_type &tkey)const{
+            Node *pnode = root;
+            while (pnode) {
+                if (tkey < pnode->NodePair.first) pnode = pnode->left;
+                else if (pnode->NodePair.first < tkey) pnode = pnode->right;
+                else return pnode;
+            }
+            return NULL;
+        }
+
+        static Node *findFirst(Node *pnode){
+            if ( !pnode ) return NULL;
+            while (pnode->left) pnode = pnode->left;
+            return pnode;
+        }
+
+        static Node *findLast(Node *pnode){
+            if ( !pnode ) return NULL;
+            while (pnode->right) pnode = pnode->right;
+            return pnode;
+        }
+
+        //Następnik i poprzednik wyznaczamy po wskaźnikach na rodzica - bez porównywania kluczy
+        //i bez schodzenia od korzenia, więc przejście całego drzewa to O(n) kroków
+        static Node *nextNode(Node *n){
+            // Prawa gałąź nie jest pusta
+            if( n->right != NULL )
+                return findFirst(n->right);
+            // W innym przypadku wspinamy się, dopóki jesteśmy prawym dzieckiem
+            Node *p = n->parent;
+            while (p != NULL && n == p->right) {
+                n = p;
+                p = p->parent;
+            }
+            return p;
+        }
+
+        static Node *previousNode(Node *n){
+            //Lewa gałąź nie jest pusta
+            if( n->left != NULL )
+                return findLast(n->left);
+            // W innym przypadku wspinamy się, dopóki jesteśmy lewym dzieckiem
+            Node *p = n->parent;
+            while (p != NULL && n == p->left) {
+                n = p;
+                p = p->parent;
+            }
+            return p;
+        }
+
+        //Węzły żyją w puli drzewa (albo w slabie), więc pamięć oddajemy całymi blokami. Po drzewie chodzimy tylko
+        //po to, żeby wywołać nietrywialne destruktory - rotacjami w prawo prostujemy je w listę,
+        //bez rekursji i bez stosu.
+        void clean(){
+            if (!std::is_trivially_destructible<value_type>::value) {
+                Node *p = root;
+                while (p) {
+                    if (p->left) {
+                        Node *l = p->left;
+                        p->left = l->right;
+                        l->right = p;
+                        p = l;
+                    } else {
+                        Node *next = p->right;
+                        pool.forget(p);
+                        p = next;
+                    }
+                }
+            }
+            pool.release();
+            slab.release();
+            root = NULL;
+            leftmost = NULL;
+            rightmost = NULL;
+            count = 0;
         }
     };
 
+    template<typename KeyType, typename ValueType>
+    constexpr typename TreeMap<KeyType, ValueType>::size_type TreeMap<KeyType, ValueType>::SMALL_MAP_SIZE;
+
     template<typename KeyType, typename ValueType>
     class TreeMap<KeyType, ValueType>::ConstIterator {
     public:
@@ -365,61 +700,14 @@ namespace aisdi {
     protected:
         const TreeMap *ttree;
         Node *currentNode;
-        Node *findMinNode(Node *pnode){
-            return pnode->left ? findMinNode(pnode->left) : pnode;
-        }
         Node *inOrderSuccessor(Node *n)
         {
-            Node *root = ttree->root;
-            // Prawa gałąź nie jest pusta
-            if( n->right != NULL )
-                return findMinNode(n->right);
-            Node *succ = NULL;
-
-            // W innym przypadku
-            while (root != NULL)
-            {
-                if (n->NodePair.first < root->NodePair.first)
-                {
-                    succ = root;
-                    root = root->left;
-                }
-                else if (n->NodePair.first > root->NodePair.first)
-                    root = root->right;
-                else
-                    break;
-            }
-            return succ;
+            return TreeMap::nextNode(n);
         }
         Node *inOrderPredeccessor(Node *n) {
-            Node *root = ttree->root;
-            //Drzewo jest puste
-            if( !root ) return NULL;
-            //Dekrementujemy end()
-            if( !n ){
-                while(root->right != NULL) root = root->right;
-                return root;
-            }
-            //Lewa gałąź nie jest pusta
-            if( n->left != NULL )
-                return n->left;
-            Node *succ = NULL;
-
-            // W innym przypadku
-            while (root != NULL)
-            {
-                if (n->NodePair.first < root->NodePair.first)
-                {
-                    root = root->left;
-                }
-                else if (n->NodePair.first > root->NodePair.first){
-                    succ = root;
-                    root = root->right;
-                }
-                else
-                    break;
-            }
-            return succ;
+            //Dekrementujemy end() - ostatni węzeł jest zapamiętany w drzewie
+            if( !n ) return ttree->rightmost;
+            return TreeMap::previousNode(n);
         }
     };
 
@@ -466,19 +754,57 @@ namespace aisdi {
         }
     };
 
+    //Lekki widok na przedział [first, last) - trzyma tylko dwa iteratory, nie kopiuje elementów
+    template<typename KeyType, typename ValueType>
+    template<typename RangeIterator>
+    class TreeMap<KeyType, ValueType>::RangeView {
+    public:
+        RangeView(const RangeIterator &tfirst, const RangeIterator &tlast) : first(tfirst), last(tlast) {}
+
+        RangeIterator begin() const {
+            return first;
+        }
+
+        RangeIterator end() const {
+            return last;
+        }
+
+        bool isEmpty() const {
+            return first == last;
+        }
+
+    private:
+        RangeIterator first;
+        RangeIterator last;
+    };
+
     template<typename KeyType, typename ValueType>
     struct TreeMap<KeyType, ValueType>::Node {
         friend class TreeMap;
-        Node(KeyType tkey, ValueType tvalue):NodePair(tkey, tvalue) {
+        Node(const KeyType &tkey, const ValueType &tvalue):NodePair(tkey, tvalue) {
             height = 1;
+            size = 1;
             right = NULL;
             left = NULL;
+            parent = NULL;
             NodePair.second = tvalue;
         }
 
+        template<typename... Args>
+        Node(std::piecewise_construct_t pc, Args &&... args):NodePair(pc, std::forward<Args>(args)...) {
+            height = 1;
+            size = 1;
+            right = NULL;
+            left = NULL;
+            parent = NULL;
+        }
+
         Node *right;
         Node *left;
+        Node *parent;
         unsigned char height;
+        //Liczba węzłów w poddrzewie - mieści się w wyrównaniu za height, więc węzeł nie rośnie
+        unsigned int size;
         std::pair<const KeyType, ValueType> NodePair;
     };
 
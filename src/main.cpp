@@ -1,16 +1,30 @@
 #include <cstddef>
 #include <cstdlib>
 #include <string>
+#include <random>
+#include <vector>
+#include <limits>
+#include <memory>
+#include <chrono>
+#include <functional>
 
 #include "TreeMap.h"
 #include "../CODEine-master/benchmark.h"
 #include "HashMap.h"
+#include "RobinHoodHashMap.h"
+#include "SwissHashMap.h"
+#include "BPlusTreeMap.h"
+#include "FlatHashMap.h"
 
 namespace {
 
     template<typename K, typename V>
     using Map = aisdi::TreeMap<K, V>;
 
+    template<typename Reduction>
+    using ReducedHashMap = aisdi::HashMap<int, int, aisdi::SeededHash<int>, std::equal_to<int>,
+                                          std::allocator<std::pair<const int, int>>, Reduction>;
+
     template<class T>
     void benchmarking(int numberEle) {
         T tree;
@@ -25,6 +39,35 @@ namespace {
         }
     }
 
+    //Mierzy tylko wyszukiwanie: budowa mapy i jej zniszczenie (koniec zakresu) są doliczane do timeoutu
+    //i odejmowane od wyniku. Połowa wyszukiwań trafia w istniejące klucze, połowa (klucze ujemne) chybia.
+    template<class T>
+    bmk::timeout_ptr<std::chrono::microseconds> lookupBenchmarking(int numberEle) {
+        auto setup = std::make_unique<bmk::timeout<std::chrono::microseconds>>();
+        {
+            setup->tic();
+            T map;
+            std::vector<int> keys;
+            keys.reserve(numberEle);
+            std::mt19937 eng(numberEle);
+            std::uniform_int_distribution<int> distr(0, std::numeric_limits<int>::max());
+            for (int i = 0; i < numberEle; i++) {
+                keys.push_back(distr(eng));
+                map[keys.back()] = i;
+            }
+            setup->toc();
+
+            int found = 0;
+            for (int i = 0; i < numberEle; i++) {
+                if (map.find(keys[i]) != map.end()) ++found;
+                if (map.find(-keys[i] - 1) != map.end()) ++found;
+            }
+            bmk::doNotOptimizeAway(found);
+            setup->tic();
+        }
+        setup->toc();
+        return setup;
+    }
 
     void perfomTest() {
         Map<int, std::string> map;
@@ -42,8 +85,38 @@ int main(int argc, char **argv) {
 
     bm.run("TreeMap", 10, benchmarking<aisdi::TreeMap<int, int>>, "number of elements",
            {10, 30, 60, 100, 200, 300, 600, 1000, 2000, 3000, 6000, 10000, 30000, 60000, 100000, 200000});
+    bm.run("BPlusTreeMap", 10, benchmarking<aisdi::BPlusTreeMap<int, int>>, "number of elements",
+           {10, 30, 60, 100, 200, 300, 600, 1000, 2000, 3000, 6000, 10000, 30000, 60000, 100000, 200000});
     bm.run("HashMap", 10, benchmarking<aisdi::HashMap<int, int>>, "number of elements",
            {10, 30, 60, 100, 200, 300, 600, 1000, 2000, 3000, 6000, 10000, 30000, 60000, 100000, 200000});
+    bm.run("FlatHashMap", 10, benchmarking<aisdi::FlatHashMap<int, int>>, "number of elements",
+           {10, 30, 60, 100, 200, 300, 600, 1000, 2000, 3000, 6000, 10000, 30000, 60000, 100000, 200000});
     bm.serialize("Randomly inserting ints", "TreevsVectorInserting.txt");
 
+    bmk::benchmark<std::chrono::microseconds> lookups;
+
+    lookups.run("TreeMap", 10, lookupBenchmarking<aisdi::TreeMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.run("BPlusTreeMap", 10, lookupBenchmarking<aisdi::BPlusTreeMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.run("HashMap", 10, lookupBenchmarking<aisdi::HashMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.run("RobinHoodHashMap", 10, lookupBenchmarking<aisdi::RobinHoodHashMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.run("SwissHashMap", 10, lookupBenchmarking<aisdi::SwissHashMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.run("FlatHashMap", 10, lookupBenchmarking<aisdi::FlatHashMap<int, int>>, "number of elements",
+                {1000, 10000, 100000, 1000000});
+    lookups.serialize("Looking up hits and misses", "RandomLookups.txt");
+
+    bmk::benchmark<std::chrono::microseconds> reductions;
+
+    reductions.run("Modulo", 10, lookupBenchmarking<ReducedHashMap<aisdi::hashing::ModuloReduction>>,
+                   "number of elements", {1000, 10000, 100000, 1000000});
+    reductions.run("PowerOfTwo", 10, lookupBenchmarking<ReducedHashMap<aisdi::hashing::PowerOfTwoReduction>>,
+                   "number of elements", {1000, 10000, 100000, 1000000});
+    reductions.run("FastRange", 10, lookupBenchmarking<ReducedHashMap<aisdi::hashing::FastRangeReduction>>,
+                   "number of elements", {1000, 10000, 100000, 1000000});
+    reductions.serialize("HashMap lookups by bucket index reduction", "HashReductionLookups.txt");
+
 }
@@ -0,0 +1,102 @@
+#include <BPlusTreeMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+//Mały fanout wymusza wielopoziomowe drzewo już przy kilkuset elementach
+template <typename K>
+using NarrowMap = aisdi::BPlusTreeMap<K, std::string, 4>;
+
+BOOST_AUTO_TEST_SUITE(BPlusTreeMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNarrowTree_WhenInsertingAndRemovingManyItems_ThenItemsMatchStdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  NarrowMap<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const int key = (i * 7919) % 2048;
+    if (i % 3 == 2 && expected.erase(key))
+      map.remove(key);
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  BOOST_CHECK_GT(map.getHeight(), 3);
+  BOOST_CHECK_EQUAL(map.getSize(), expected.size());
+  auto expectedIt = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expectedIt)
+  {
+    BOOST_REQUIRE(expectedIt != expected.end());
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+    BOOST_CHECK_EQUAL(it->second, expectedIt->second);
+  }
+  BOOST_CHECK(expectedIt == expected.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNarrowTree_WhenIteratingBackward_ThenKeysAreReverseSorted,
+                              K,
+                              TestedKeyTypes)
+{
+  NarrowMap<K> map;
+  for (int i = 0; i < 500; ++i)
+    map[(i * 37) % 500] = std::to_string(i);
+
+  int expectedKey = 500;
+  for (auto it = map.end(); it != map.begin();)
+  {
+    --it;
+    BOOST_CHECK_EQUAL(it->first, --expectedKey);
+  }
+  BOOST_CHECK_EQUAL(expectedKey, 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNarrowTree_WhenRemovingAllItems_ThenTreeBecomesEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  NarrowMap<K> map;
+  for (int i = 0; i < 1000; ++i)
+    map[i] = std::to_string(i);
+  for (int i = 999; i >= 0; i -= 2)
+    map.remove(i);
+  for (int i = 0; i < 1000; i += 2)
+    map.remove(i);
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK_EQUAL(map.getHeight(), 0);
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNarrowTree_WhenCopying_ThenCopyIsIndependent,
+                              K,
+                              TestedKeyTypes)
+{
+  NarrowMap<K> map;
+  for (int i = 0; i < 300; ++i)
+    map[i] = std::to_string(i);
+
+  NarrowMap<K> copy{map};
+  map.remove(150);
+  copy[1000] = "Alice";
+
+  BOOST_CHECK_EQUAL(copy.getSize(), 301);
+  BOOST_CHECK_EQUAL(copy.valueOf(150), "150");
+  BOOST_CHECK(map.find(1000) == map.end());
+  BOOST_CHECK_EQUAL((--copy.end())->first, 1000);
+  BOOST_CHECK_EQUAL(copy.begin()->first, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
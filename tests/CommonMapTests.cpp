@@ -0,0 +1,678 @@
+#include <BPlusTreeMap.h>
+#include <FixedHashMap.h>
+#include <FlatHashMap.h>
+#include <RobinHoodHashMap.h>
+#include <SwissHashMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "MapTestHelpers.h"
+
+//Wspólny zestaw testów interfejsu mapy - każdy silnik dopisuje tu swoje typy,
+//a w swoim pliku trzyma tylko testy specyficzne dla siebie
+using TestedMapTypes = boost::mpl::list<aisdi::RobinHoodHashMap<std::int32_t, std::string>,
+                                        aisdi::RobinHoodHashMap<std::uint64_t, std::string>,
+                                        aisdi::SwissHashMap<std::int32_t, std::string>,
+                                        aisdi::SwissHashMap<std::uint64_t, std::string>,
+                                        aisdi::BPlusTreeMap<std::int32_t, std::string>,
+                                        aisdi::BPlusTreeMap<std::uint64_t, std::string>,
+                                        aisdi::FixedHashMap<std::int32_t, std::string, 64>,
+                                        aisdi::FixedHashMap<std::uint64_t, std::string, 64>,
+                                        aisdi::FlatHashMap<std::int32_t, std::string>,
+                                        aisdi::FlatHashMap<std::uint64_t, std::string>>;
+
+//Silniki bez górnego limitu rozmiaru - na nich sprawdzamy wzrost tablicy przy tysiącach elementów
+using GrowingMapTypes = boost::mpl::list<aisdi::RobinHoodHashMap<std::int32_t, std::string>,
+                                         aisdi::RobinHoodHashMap<std::uint64_t, std::string>,
+                                         aisdi::SwissHashMap<std::int32_t, std::string>,
+                                         aisdi::SwissHashMap<std::uint64_t, std::string>,
+                                         aisdi::BPlusTreeMap<std::int32_t, std::string>,
+                                         aisdi::BPlusTreeMap<std::uint64_t, std::string>,
+                                         aisdi::FlatHashMap<std::int32_t, std::string>,
+                                         aisdi::FlatHashMap<std::uint64_t, std::string>>;
+
+//Hashmapy z ziarnem SeededHash
+using SeededMapTypes = boost::mpl::list<aisdi::RobinHoodHashMap<std::int32_t, std::string>,
+                                        aisdi::RobinHoodHashMap<std::uint64_t, std::string>,
+                                        aisdi::SwissHashMap<std::int32_t, std::string>,
+                                        aisdi::SwissHashMap<std::uint64_t, std::string>,
+                                        aisdi::FixedHashMap<std::int32_t, std::string, 64>,
+                                        aisdi::FixedHashMap<std::uint64_t, std::string, 64>,
+                                        aisdi::FlatHashMap<std::int32_t, std::string>,
+                                        aisdi::FlatHashMap<std::uint64_t, std::string>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(CommonMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAddingItem_ThenItIsNoLongerEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  using K = typename M::key_type;
+
+  M map;
+
+  map[K{}] = std::string{};
+
+  BOOST_CHECK(!map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenGettingIterators_ThenBeginEqualsEnd,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  BOOST_CHECK(begin(map) == end(map));
+  BOOST_CHECK(const_cast<const M&>(map).begin() == map.end());
+  BOOST_CHECK(map.cbegin() == map.cend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenGettingIterator_ThenBeginIsNotEnd,
+                              M,
+                              TestedMapTypes)
+{
+  using K = typename M::key_type;
+
+  M map;
+  map[K{}] = std::string{};
+
+  BOOST_CHECK(begin(map) != end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithOnePair_WhenIterating_ThenPairIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[753] = "Rome";
+
+  auto it = map.begin();
+
+  BOOST_CHECK_EQUAL(it->first, 753);
+  BOOST_CHECK_EQUAL(it->second, "Rome");
+  BOOST_CHECK(++it == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostIncrementing_ThenPreviousPositionIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  using K = typename M::key_type;
+
+  M map;
+  map[K{}] = std::string{};
+
+  auto it = map.begin();
+  auto postIncrementedIt = it++;
+
+  BOOST_CHECK(postIncrementedIt == map.begin());
+  BOOST_CHECK(it == map.end());
+  BOOST_CHECK(postIncrementedIt == map.cbegin());
+  BOOST_CHECK(it == map.cend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreIncrementing_ThenNewPositionIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  using K = typename M::key_type;
+
+  M map;
+  map[K{}] = std::string{};
+
+  auto it = map.begin();
+  auto preIncrementedIt = ++it;
+
+  BOOST_CHECK(preIncrementedIt == it);
+  BOOST_CHECK(it == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementing_ThenOperationThrows,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  BOOST_CHECK_THROW(map.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(++(map.end()), std::out_of_range);
+  BOOST_CHECK_THROW(map.cend()++, std::out_of_range);
+  BOOST_CHECK_THROW(++(map.cend()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDecrementing_ThenIteratorPointsToLastItem,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[1] = std::string{};
+
+  auto it = map.end();
+  --it;
+
+  BOOST_CHECK(it == begin(map));
+  BOOST_CHECK_EQUAL(it->first, 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreDecrementing_ThenNewIteratorValueIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[1] = std::string{};
+
+  auto it = map.end();
+  auto preDecremented = --it;
+
+  BOOST_CHECK(it == preDecremented);
+  BOOST_CHECK_EQUAL(it->first, 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostDecrementing_ThenOldIteratorValueIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[1] = std::string{};
+
+  auto it = map.end();
+  auto postDecremented = it--;
+
+  BOOST_CHECK(postDecremented == map.end());
+  BOOST_CHECK_EQUAL(it->first, 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBeginIterator_WhenDecrementing_ThenOperationThrows,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  BOOST_CHECK_THROW(map.begin()--, std::out_of_range);
+  BOOST_CHECK_THROW(--(map.begin()), std::out_of_range);
+  BOOST_CHECK_THROW(map.cbegin()--, std::out_of_range);
+  BOOST_CHECK_THROW(--(map.cbegin()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDereferencing_ThenOperationThrows,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  BOOST_CHECK_THROW(*map.end(), std::out_of_range);
+  BOOST_CHECK_THROW(*map.cend(), std::out_of_range);
+  BOOST_CHECK_THROW(map.end()->first, std::out_of_range);
+  BOOST_CHECK_THROW(map.cend()->second, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConstIterator_WhenDereferencing_ThenItemIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[42] = "Answer";
+
+  const auto it = map.cbegin();
+
+  BOOST_CHECK_EQUAL(it->first, 42);
+  BOOST_CHECK_EQUAL(it->second, "Answer");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenSearchingForKey_ThenEndIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+
+  const auto it = map.find(123);
+
+  BOOST_CHECK(it == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenSearchingForMissingKey_ThenEndIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[321] = "Not it";
+
+  const auto it = map.find(123);
+
+  BOOST_CHECK(it == end(map));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenSearchingForKey_ThenItemIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[321] = "Not it";
+  map[123] = "It!";
+
+  const auto it = map.find(123);
+
+  BOOST_CHECK(it != end(map));
+  BOOST_CHECK_EQUAL(it->first, 123);
+  BOOST_CHECK_EQUAL(it->second, "It!");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenGettingSize_ThenZeroIsReturnd,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+
+  BOOST_CHECK_EQUAL(map.getSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenGettingSize_ThenItemCountIsReturnd,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  map[1] = "1";
+  map[2] = "1";
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInitializingFromListOfPairs_ThenAllItemsAreInMap,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Chuck" }, { 27, "Bob" } };
+
+  auto it = map.find(42);
+  it->second = "Alice";
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAddingItem_ThenItemIsInMap,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  map[42] = "Alice";
+
+  thenMapContainsItems(map, { { 42, "Alice" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenChangingItem_ThenNewValueIsInMap,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Chuck" }, { 27, "Bob" } };
+
+  map[42] = "Alice";
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenCreatingCopy_ThenBothMapsAreEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+  const M other(map);
+
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenCreatingCopy_ThenAllItemsAreCopied,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 753, "Rome" }, { 1789, "Paris" } };
+  const M other{map};
+
+  map[1410] = "Grunwald";
+
+  thenMapContainsItems(map, { { 1410, "Grunwald" }, { 753, "Rome" }, { 1789, "Paris" } });
+  thenMapContainsItems(other, { { 753, "Rome" }, { 1789, "Paris" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenMovingToOther_ThenBothMapsAreEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  M other{std::move(map)};
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(other.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenMovingToOther_ThenAllItemsAreMoved,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 753, "Rome" }, { 1789, "Paris" } };
+  const M other{std::move(map)};
+
+  thenMapContainsItems(other, { { 753, "Rome" }, { 1789, "Paris" } });
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAssigningToOther_ThenOtherMapIsEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+  M other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  other = map;
+
+  BOOST_CHECK(other.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenAssigningToOther_ThenAllElementsAreCopied,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 753, "Rome" }, { 1789, "Paris" } };
+  M other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  other = map;
+  map[1410] = "Grunwald";
+
+  thenMapContainsItems(other, { { 753, "Rome" }, { 1789, "Paris" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenSelfAssigning_ThenNothingHappens,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  map = map;
+
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenSelfAssigning_ThenNothingHappens,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  map = map;
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenMoveAssigning_ThenBothMapsAreEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+  M other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  other = std::move(map);
+
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyMap_WhenMoveAssigning_ThenAllElementsAreMoved,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 753, "Rome" }, { 1789, "Paris" } };
+  M other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  other = std::move(map);
+
+  thenMapContainsItems(other, { { 753, "Rome" }, { 1789, "Paris" } });
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenReadingValueOfAnyKey_ThenExceptionIsThrown,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+
+  BOOST_CHECK_THROW(map.valueOf(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenReadingValueOfMissingKey_ThenExceptionIsThrown,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK_THROW(map.valueOf(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenReadingValueOfAKey_ThenValueIsReturned,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Alice");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenChangingValueOfAKey_ThenValueIsChanged,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  map.valueOf(42) = "Chuck";
+
+  thenMapContainsItems(map, { { 42, "Chuck" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenRemovingValueByKey_ThenExceptionIsThrown,
+                              M,
+                              TestedMapTypes)
+{
+  M map;
+
+  BOOST_CHECK_THROW(map.remove(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingValueByWrongKey_ThenExceptionIsThrown,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK_THROW(map.remove(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingValueByKey_ThenItemIsRemoved,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  map.remove(27);
+
+  thenMapContainsItems(map, { { 42, "Alice" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSingleItemMap_WhenRemovingValueByKey_ThenMapBecomesEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 27, "Bob" } };
+
+  map.remove(27);
+
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenErasingEnd_ThenExceptionIsThrown,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK_THROW(map.remove(end(map)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyMap_WhenRemovingItemByIterator_ThenItemIsRemoved,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  map.remove(map.find(42));
+
+  thenMapContainsItems(map, { { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSingleItemMap_WhenRemovingItemByIterator_ThenMapBecomesEmpty,
+                              M,
+                              TestedMapTypes)
+{
+  M map = { { 42, "Alice" } };
+
+  map.remove(map.find(42));
+
+  BOOST_CHECK(map.isEmpty());
+}
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoEmptyMaps_WhenComparingThem_ThenTheyAreReportedAsEqual,
+                              M,
+                              TestedMapTypes)
+{
+  const M map;
+  const M other;
+
+  BOOST_CHECK(map == other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoEqualMaps_WhenComparingThem_ThenTheyAreReportedAsEqual,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+  const M other = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK(map == other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoEquivalentMaps_WhenComparingThem_ThenTheyAreReportedAsEqual,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+  const M other = { { 27, "Bob" }, { 42, "Alice" } };
+
+  BOOST_CHECK(map == other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentValues_WhenComparingThem_ThenTheyAreNotEqual,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" } };
+  const M other = { { 27, "Alice" }, { 42, "Bob" } };
+
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_ThenTheyAreNotEqual,
+                              M,
+                              TestedMapTypes)
+{
+  const M map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  const M other = { { 27, "Alice" }, { 42, "Bob" } };
+
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAddingAndRemovingManyItems_ThenItemsMatchStdMap,
+                              M,
+                              GrowingMapTypes)
+{
+  using K = typename M::key_type;
+
+  M map;
+  std::map<K, std::string> expected;
+
+  for (int i = 0; i < 20000; ++i)
+  {
+    const int key = (i * 7919) % 3000 * 1024;
+    if (expected.erase(key))
+      map.remove(key);
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  thenMapContainsItems(map, expected);
+  for (int i = 0; i < 3000; ++i)
+    if (!expected.count(i * 1024))
+      BOOST_CHECK(map.find(i * 1024) == map.end());
+
+  std::size_t forward = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++forward;
+  std::size_t backward = 0;
+  for (auto it = map.end(); it != map.begin(); --it)
+    ++backward;
+  BOOST_CHECK_EQUAL(forward, expected.size());
+  BOOST_CHECK_EQUAL(backward, expected.size());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithSameSeed_WhenAddingSameItems_ThenLayoutIsTheSame,
+                              M,
+                              SeededMapTypes)
+{
+  const typename M::hasher hash(42);
+  M first(hash);
+  M second(hash);
+  for (int i = 0; i < 50; ++i)
+  {
+    first[i * 1024] = std::to_string(i);
+    second[i * 1024] = std::to_string(i);
+  }
+  const M copy{first};
+
+  BOOST_CHECK_EQUAL(copy.getHashFunction().getSeed(), 42u);
+  auto secondIt = second.begin();
+  for (const auto& item : first)
+    BOOST_CHECK_EQUAL(item.first, (secondIt++)->first);
+  BOOST_CHECK(first == copy);
+}
+
+// ConstIterator is tested via Iterator methods.
+// If Iterator methods are to be changed, then new ConstIterator tests are required.
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+#include <FixedHashMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "MapTestHelpers.h"
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template<typename K>
+using Map = aisdi::FixedHashMap<K, std::string, 64>;
+
+//Globalne operatory new/delete podmienione na liczące alokacje - FixedHashMap nie powinna ich nigdy wołać.
+//Podmieniamy wszystkie warianty, żeby każda para new/delete trafiała do tego samego malloc/free.
+namespace {
+    std::size_t heapAllocations = 0;
+
+    void *countedAllocate(std::size_t size) noexcept {
+      ++heapAllocations;
+      return std::malloc(size ? size : 1);
+    }
+}
+
+void *operator new(std::size_t size) {
+  if (void *memory = countedAllocate(size))
+    return memory;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAllocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+BOOST_AUTO_TEST_SUITE(FixedHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFixedMap_WhenCheckingLayout_ThenSlotsAreStoredInline,
+                              K,
+                              TestedKeyTypes)
+{
+  using SmallMap = aisdi::FixedHashMap<K, std::string, 256>;
+
+  BOOST_CHECK_EQUAL(SmallMap::getCapacity(), 256);
+  BOOST_CHECK_EQUAL(SmallMap::SLOT_COUNT, 512);
+  BOOST_CHECK_EQUAL(SmallMap::MASK, 511);
+  BOOST_CHECK(sizeof(SmallMap) >= SmallMap::SLOT_COUNT * sizeof(typename SmallMap::value_type));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullMap_WhenAddingNewKey_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 64; ++i)
+    map[i * 1024] = std::to_string(i);
+
+  BOOST_CHECK_THROW(map[1], std::length_error);
+  map[0] = "Alice";
+  BOOST_CHECK_EQUAL(map.getSize(), 64);
+  BOOST_CHECK_EQUAL(map.valueOf(0), "Alice");
+
+  map.remove(0);
+  map[1] = "Bob";
+  BOOST_CHECK_EQUAL(map.valueOf(1), "Bob");
+  for (int i = 1; i < 64; ++i)
+    BOOST_CHECK_EQUAL(map.valueOf(i * 1024), std::to_string(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullMap_WhenRemovingAndAddingRepeatedly_ThenItemsAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const int key = (i * 7919) % 100;
+    if (expected.count(key) || expected.size() == 64)
+    {
+      if (expected.erase(key))
+        map.remove(key);
+    }
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFixedMap_WhenAddingCopyingMovingAndRemovingItems_ThenNothingIsAllocated,
+                              K,
+                              TestedKeyTypes)
+{
+  using IntMap = aisdi::FixedHashMap<K, int, 64>;
+  IntMap warmUp;
+  warmUp[0] = 0;
+  const std::size_t beforeProbe = heapAllocations;
+  const std::string probe(100, 'x');
+  BOOST_REQUIRE(heapAllocations > beforeProbe);
+
+  const std::size_t before = heapAllocations;
+  int sum = 0;
+  std::size_t size = 0;
+  {
+    IntMap map;
+    for (int i = 0; i < 64; ++i)
+      map[i * 1024] = i;
+    IntMap copy{map};
+    IntMap moved{std::move(map)};
+    for (int i = 0; i < 64; i += 2)
+      moved.remove(i * 1024);
+    copy = moved;
+    for (const auto& item : copy)
+      sum += item.second;
+    size = copy.getSize();
+  }
+  const std::size_t after = heapAllocations;
+
+  BOOST_CHECK_EQUAL(after - before, 0u);
+  BOOST_CHECK_EQUAL(size, 32u);
+  BOOST_CHECK_EQUAL(sum, 32 * 32);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#include <FlatHashMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "MapTestHelpers.h"
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template<typename K>
+using Map = aisdi::FlatHashMap<K, std::string>;
+
+template<typename K>
+using ScalarMap = aisdi::FlatHashMap<K, std::string, aisdi::flat::ScalarMatcher>;
+
+//Wszystkie klucze trafiają do grupy 0 - od dziewiątego elementu każdy przelewa się do kolejnych grup
+struct SingleGroupHash
+{
+  template <typename K>
+  std::size_t operator()(const K&) const { return 0; }
+};
+
+template<typename K>
+using SingleGroupMap = aisdi::FlatHashMap<K, std::string, typename aisdi::flat::DefaultMatcher<K>::type,
+                                          SingleGroupHash>;
+
+BOOST_AUTO_TEST_SUITE(FlatHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenKeyWindow_WhenMatchingKey_ThenOnlyUsedEqualSlotsAreReported,
+                              K,
+                              TestedKeyTypes)
+{
+  using DefaultMatcher = typename aisdi::flat::DefaultMatcher<K>::type;
+  const K keys[8] = { 5, 7, 5, 0, 9, 5, 0, 7 };
+
+  BOOST_CHECK_EQUAL(DefaultMatcher::match(keys, 0xFF, K(5)), 0x25u);
+  BOOST_CHECK_EQUAL(DefaultMatcher::match(keys, 0xDF, K(5)), 0x05u);
+  BOOST_CHECK_EQUAL(DefaultMatcher::match(keys, 0x37, K(0)), 0x00u);
+  BOOST_CHECK_EQUAL(DefaultMatcher::match(keys, 0xFF, K(8)), 0x00u);
+  BOOST_CHECK_EQUAL(aisdi::flat::ScalarMatcher::match(keys, 0xFF, K(7)), 0x82u);
+  BOOST_CHECK_EQUAL(aisdi::flat::ScalarMatcher::match(keys, 0x7F, K(7)), 0x02u);
+  BOOST_CHECK_EQUAL(aisdi::flat::UnrolledMatcher::match(keys, 0xFF, K(5)), 0x25u);
+  BOOST_CHECK_EQUAL(aisdi::flat::UnrolledMatcher::match(keys, 0x37, K(0)), 0x00u);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenScalarMatcherMap_WhenAddingAndRemovingItems_ThenItBehavesLikeDefaultMap,
+                              K,
+                              TestedKeyTypes)
+{
+  ScalarMap<K> scalar;
+  Map<K> map;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    scalar[i * 3] = std::to_string(i);
+    map[i * 3] = std::to_string(i);
+  }
+  for (int i = 0; i < 1000; i += 5)
+  {
+    scalar.remove(i * 3);
+    map.remove(i * 3);
+  }
+
+  BOOST_CHECK_EQUAL(scalar.getSize(), map.getSize());
+  BOOST_CHECK_EQUAL(scalar.getCapacity(), map.getCapacity());
+  for (const auto &item : map)
+  {
+    const auto it = scalar.find(item.first);
+    BOOST_REQUIRE(it != scalar.end());
+    BOOST_CHECK_EQUAL(it->second, item.second);
+  }
+  BOOST_CHECK(scalar.find(0) == scalar.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCustomHash_WhenKeysOverflowTheirGroup_ThenOverflowCountersKeepThemReachable,
+                              K,
+                              TestedKeyTypes)
+{
+  SingleGroupMap<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 12; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  //Grupa 0 jest pełna, więc wyszukiwanie idzie dalej po licznikach overflow; po usunięciu
+  //przelanych elementów liczniki wracają do zera, a zwolnione miejsce w grupie 0 jest zajmowane ponownie
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK(map.find(100) == map.end());
+
+  for (int i = 8; i < 12; ++i)
+  {
+    map.remove(i);
+    expected.erase(i);
+  }
+  map.remove(0);
+  expected.erase(0);
+  map[12] = "12";
+  expected[12] = "12";
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK(map.find(8) == map.end());
+  BOOST_CHECK_EQUAL(map.begin()->first, 12);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapWithStringKeys_WhenAddingAndRemovingItems_ThenScalarFallbackFindsThem)
+{
+  aisdi::FlatHashMap<std::string, int> map;
+  for (int i = 0; i < 500; ++i)
+    map["key" + std::to_string(i)] = i;
+  for (int i = 0; i < 500; i += 2)
+    map.remove("key" + std::to_string(i));
+
+  aisdi::FlatHashMap<std::string, int> copy{map};
+  aisdi::FlatHashMap<std::string, int> moved{std::move(map)};
+
+  BOOST_CHECK_EQUAL(moved.getSize(), 250);
+  BOOST_CHECK(copy == moved);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(moved.find("key0") == moved.end());
+  BOOST_CHECK_EQUAL(moved.valueOf("key499"), 499);
+  BOOST_CHECK_EQUAL(copy.valueOf("key1"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
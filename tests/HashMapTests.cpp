@@ -4,6 +4,10 @@
 #include <string>
 #include <map>
 #include <iostream>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <boost/test/unit_test.hpp>
 
 #include <boost/mpl/list.hpp>
@@ -16,10 +20,104 @@ using Map = aisdi::HashMap<K, std::string>;
 using std::begin;
 using std::end;
 
+namespace
+{
+  std::size_t allocationCount = 0;
+
+  template <typename T>
+  struct CountingAllocator
+  {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+      ++allocationCount;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+  };
+
+  //Klucze równe modulo 1000 są traktowane jak ten sam klucz
+  struct ModuloHash
+  {
+    template <typename K>
+    std::size_t operator()(K key) const { return std::hash<K>{}(key % 1000); }
+  };
+
+  struct ModuloEqual
+  {
+    template <typename K>
+    bool operator()(K a, K b) const { return a % 1000 == b % 1000; }
+  };
+
+  template <typename K, typename Reduction>
+  using ReducedMap = aisdi::HashMap<K, std::string, aisdi::SeededHash<K>, std::equal_to<K>,
+                                    std::allocator<std::pair<const K, std::string>>, Reduction>;
+
+  template <typename K, typename Reduction>
+  void checkAddingAndRemovingWithReduction()
+  {
+    ReducedMap<K, Reduction> map(100);
+    for (int i = 0; i < 1000; ++i)
+      map[i * 1024] = std::to_string(i);
+    for (int i = 0; i < 1000; i += 2)
+      map.remove(i * 1024);
+
+    BOOST_CHECK_EQUAL(map.getSize(), 500);
+    for (int i = 0; i < 1000; ++i)
+      BOOST_CHECK_EQUAL(map.find(i * 1024) != map.end(), i % 2 == 1);
+    std::size_t visited = 0;
+    for (auto it = map.begin(); it != map.end(); ++it)
+      ++visited;
+    BOOST_CHECK_EQUAL(visited, 500);
+  }
+
+  //Wartość, której kopiowanie rzuca, gdy skończy się limit kopii
+  struct ThrowingValue
+  {
+    static int copiesLeft;
+
+    std::string text;
+
+    ThrowingValue() = default;
+
+    ThrowingValue(const std::string& text) : text(text) {}
+
+    ThrowingValue(const ThrowingValue& other) : text(other.text)
+    {
+      if (copiesLeft-- == 0)
+        throw std::runtime_error("copy failed");
+    }
+
+    ThrowingValue& operator=(const ThrowingValue&) = default;
+  };
+
+  int ThrowingValue::copiesLeft = -1;
+
+  template <typename K>
+  using CountingMap = aisdi::HashMap<K, std::string, aisdi::SeededHash<K>, std::equal_to<K>,
+                                     CountingAllocator<std::pair<const K, std::string>>>;
+}
+
 BOOST_AUTO_TEST_SUITE(HashMapsTests)
 
-    template<typename K>
-    void thenMapContainsItems(const Map<K> &map,
+    template<typename K, typename... Params>
+    void thenMapContainsItems(const aisdi::HashMap<K, std::string, Params...> &map,
                               const std::map<K, std::string> &expected) {
         BOOST_CHECK_EQUAL(map.getSize(), expected.size());
 
@@ -590,6 +688,500 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAddingManyItems_ThenTableGrowsAndKeepsAllItems,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  const auto initialBuckets = map.getBucketCount();
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    map[i * 7] = std::to_string(i);
+    expected[i * 7] = std::to_string(i);
+  }
+
+  BOOST_CHECK(map.getBucketCount() > initialBuckets);
+  BOOST_CHECK(map.getLoadFactor() <= map.getMaxLoadFactor());
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenRemovingMostItems_ThenTableShrinks,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 4096; ++i)
+    map[i] = std::to_string(i);
+  const auto grownBuckets = map.getBucketCount();
+
+  for (int i = 0; i < 4000; ++i)
+    map.remove(i);
+
+  BOOST_CHECK(map.getBucketCount() < grownBuckets);
+  BOOST_CHECK_EQUAL(map.getSize(), 96);
+  BOOST_CHECK_EQUAL(map.valueOf(4095), "4095");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenLoweringMaxLoadFactor_ThenTableIsRehashed,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  for (int i = 100; i < 200; ++i)
+    map[i] = "x";
+
+  map.setMaxLoadFactor(0.25f);
+
+  BOOST_CHECK(map.getLoadFactor() <= 0.25f);
+  BOOST_CHECK_EQUAL(map.valueOf(13), "Chuck");
+  BOOST_CHECK_THROW(map.setMaxLoadFactor(0.0f), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyItems_WhenIteratingBothWays_ThenAllItemsAreVisited,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 300; ++i)
+    map[i * 13] = std::to_string(i);
+
+  std::size_t forward = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++forward;
+
+  std::size_t backward = 0;
+  auto it = map.end();
+  while (it != map.begin())
+  {
+    --it;
+    ++backward;
+  }
+
+  BOOST_CHECK_EQUAL(forward, 300);
+  BOOST_CHECK_EQUAL(backward, 300);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenCopyingAndDestroying_ThenNoBucketsAreAllocated,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other{map};
+  Map<K> assigned;
+  assigned = other;
+
+  BOOST_CHECK_EQUAL(map.getBucketCount(), 0);
+  BOOST_CHECK_EQUAL(other.getBucketCount(), 0);
+  BOOST_CHECK_EQUAL(assigned.getBucketCount(), 0);
+  BOOST_CHECK(other.find(1) == other.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenChainedItems_WhenRemovingThemFromChains_ThenOtherItemsStay,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(16, 4.0f);
+  for (int i = 0; i < 8; ++i)
+    map[i * 16] = std::to_string(i);
+
+  map.remove(map.find(3 * 16));
+  map.remove(map.find(0));
+  map.remove(7 * 16);
+
+  thenMapContainsItems(map, { { 16, "1" }, { 32, "2" }, { 64, "4" }, { 80, "5" }, { 96, "6" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithAllocator_WhenAddingItems_ThenNodesAreAllocatedInChunks,
+                              K,
+                              TestedKeyTypes)
+{
+  CountingMap<K> map;
+  allocationCount = 0;
+
+  for (int i = 0; i < 1000; ++i)
+    map[i] = std::to_string(i);
+
+  BOOST_CHECK(allocationCount > 0);
+  BOOST_CHECK(allocationCount < 100);
+  BOOST_CHECK_EQUAL(map.valueOf(999), "999");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithAllocator_WhenRemovingAndAddingItems_ThenNodesAreReused,
+                              K,
+                              TestedKeyTypes)
+{
+  CountingMap<K> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = std::to_string(i);
+  allocationCount = 0;
+
+  for (int i = 0; i < 50; ++i)
+    map.remove(i);
+  for (int i = 100; i < 150; ++i)
+    map[i] = std::to_string(i);
+
+  BOOST_CHECK_EQUAL(allocationCount, 0);
+  BOOST_CHECK_EQUAL(map.getSize(), 100);
+  BOOST_CHECK_EQUAL(map.valueOf(149), "149");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSparseMap_WhenRemovingFirstItems_ThenBeginFollowsRemainingItems,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(4096);
+  for (int i = 0; i < 200; ++i)
+    map[i * 10] = std::to_string(i);
+
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 200; ++i)
+  {
+    if (i % 50 == 49)
+      expected[i * 10] = std::to_string(i);
+    else
+      map.remove(i * 10);
+  }
+
+  std::map<K, std::string> visited;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    visited[it->first] = it->second;
+  BOOST_CHECK(visited == expected);
+
+  auto it = map.end();
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    --it;
+  BOOST_CHECK(it == map.begin());
+  BOOST_CHECK_THROW(--it, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMissingKey_WhenTryEmplacing_ThenItemIsConstructedInPlace,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  const auto result = map.tryEmplace(27, 3, 'x');
+
+  BOOST_CHECK(result.second);
+  BOOST_CHECK_EQUAL(result.first->first, 27);
+  BOOST_CHECK_EQUAL(result.first->second, "xxx");
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "xxx" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenExistingKey_WhenTryEmplacing_ThenValueIsNotChanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  const auto result = map.tryEmplace(42, "Chuck");
+
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK(result.first == map.find(42));
+  BOOST_CHECK_EQUAL(result.first->second, "Alice");
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyItems_WhenCopying_ThenLayoutAndIterationOrderAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(16, 4.0f);
+  for (int i = 0; i < 200; ++i)
+    map[i * 7] = std::to_string(i);
+
+  Map<K> copy{map};
+  Map<K> assigned = { { 42, "Alice" } };
+  assigned = map;
+
+  BOOST_CHECK_EQUAL(copy.getBucketCount(), map.getBucketCount());
+  BOOST_CHECK_EQUAL(assigned.getBucketCount(), map.getBucketCount());
+  BOOST_CHECK_EQUAL(copy.getMaxLoadFactor(), 4.0f);
+  auto copyIt = copy.begin();
+  auto assignedIt = assigned.begin();
+  for (const auto& item : map)
+  {
+    BOOST_REQUIRE(copyIt != copy.end());
+    BOOST_CHECK_EQUAL(copyIt->first, item.first);
+    BOOST_CHECK_EQUAL(copyIt->second, item.second);
+    BOOST_CHECK_EQUAL(assignedIt->first, item.first);
+    ++copyIt;
+    ++assignedIt;
+  }
+  BOOST_CHECK(copyIt == copy.end());
+  BOOST_CHECK(assignedIt == assigned.end());
+
+  map.remove(7);
+  BOOST_CHECK_EQUAL(copy.valueOf(7), "1");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMoving_ThenStorageIsTransferredWithoutAllocation,
+                              K,
+                              TestedKeyTypes)
+{
+  CountingMap<K> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = std::to_string(i);
+  const auto* item = &*map.find(42);
+  const auto buckets = map.getBucketCount();
+  CountingMap<K> assigned;
+  assigned[1] = "Alice";
+  allocationCount = 0;
+
+  CountingMap<K> moved{std::move(map)};
+  assigned = std::move(moved);
+
+  BOOST_CHECK_EQUAL(allocationCount, 0);
+  BOOST_CHECK_EQUAL(&*assigned.find(42), item);
+  BOOST_CHECK_EQUAL(assigned.getBucketCount(), buckets);
+  BOOST_CHECK_EQUAL(assigned.getSize(), 100);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK_EQUAL(map.getBucketCount(), 0);
+  BOOST_CHECK(moved.begin() == moved.end());
+
+  map[7] = "Bob";
+  BOOST_CHECK_EQUAL(map.valueOf(7), "Bob");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEqualMapsWithDifferentBucketCounts_WhenComparingThem_ThenTheyAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other(1024);
+  for (int i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    other[99 - i] = std::to_string(99 - i);
+  }
+
+  BOOST_CHECK(map == other);
+  other[42] = "Alice";
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithSameSizeAndDifferentKeys_WhenComparingThem_ThenTheyAreNotEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    other[i + 1] = std::to_string(i);
+  }
+
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAssigningToItself_ThenItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  Map<K>& self = map;
+
+  map = self;
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenKeysWithZeroedLowBits_WhenAddingThem_ThenChainsStayShort,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 4096; ++i)
+    map[i * 1024] = std::to_string(i);
+
+  std::size_t longestChain = 0;
+  for (std::size_t i = 0; i < map.getBucketCount(); ++i)
+    longestChain = std::max(longestChain, map.getBucketSize(i));
+
+  BOOST_CHECK_LT(longestChain, 16);
+  BOOST_CHECK_EQUAL(map.valueOf(4095 * 1024), "4095");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithSameSeed_WhenAddingSameKeys_ThenLayoutsAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(16, 1.0f, aisdi::SeededHash<K>(42));
+  Map<K> other(16, 1.0f, aisdi::SeededHash<K>(42));
+  for (int i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    other[i] = std::to_string(i);
+  }
+
+  BOOST_CHECK_EQUAL(map.getHashFunction().getSeed(), 42);
+  auto otherIt = other.begin();
+  for (const auto& item : map)
+    BOOST_CHECK_EQUAL(item.first, (otherIt++)->first);
+  BOOST_CHECK(map == other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCustomHashAndEquality_WhenAddingEquivalentKeys_ThenTheyShareItem,
+                              K,
+                              TestedKeyTypes)
+{
+  aisdi::HashMap<K, std::string, ModuloHash, ModuloEqual> map;
+
+  map[42] = "Alice";
+  map[1042] = "Bob";
+  map[27] = "Chuck";
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+  BOOST_CHECK_EQUAL(map.valueOf(2042), "Bob");
+  map.remove(3027);
+  BOOST_CHECK(map.find(27) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEachBucketReduction_WhenAddingAndRemovingItems_ThenItemsAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  checkAddingAndRemovingWithReduction<K, aisdi::hashing::ModuloReduction>();
+  checkAddingAndRemovingWithReduction<K, aisdi::hashing::PowerOfTwoReduction>();
+  checkAddingAndRemovingWithReduction<K, aisdi::hashing::FastRangeReduction>();
+
+  BOOST_CHECK_EQUAL((ReducedMap<K, aisdi::hashing::PowerOfTwoReduction>(100).getBucketCount()), 128);
+  BOOST_CHECK_EQUAL((ReducedMap<K, aisdi::hashing::FastRangeReduction>(100).getBucketCount()), 100);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallMap_WhenAddingItems_ThenOneBlockIsAllocatedUntilLimitIsExceeded,
+                              K,
+                              TestedKeyTypes)
+{
+  CountingMap<K> map;
+  std::map<K, std::string> expected;
+  allocationCount = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    map[i * 1024] = std::to_string(i);
+    expected[i * 1024] = std::to_string(i);
+  }
+  map.remove(3 * 1024);
+  expected.erase(3 * 1024);
+  map[3 * 1024] = "Alice";
+  expected[3 * 1024] = "Alice";
+
+  BOOST_CHECK_EQUAL(allocationCount, 1);
+  BOOST_CHECK_EQUAL(map.getBucketCount(), 1);
+  thenMapContainsItems(map, expected);
+
+  map[8 * 1024] = "Bob";
+  expected[8 * 1024] = "Bob";
+
+  BOOST_CHECK_EQUAL(allocationCount, 2);
+  BOOST_CHECK(map.getBucketCount() > 1);
+  thenMapContainsItems(map, expected);
+  std::size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++visited;
+  BOOST_CHECK_EQUAL(visited, 9);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallMap_WhenGrowingPastSmallSizeAndMoving_ThenReferencesStayValid,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  auto& value = map[1];
+  value = "Alice";
+  const auto it = map.find(1);
+  std::map<K, std::string> expected = { { 1, "Alice" } };
+
+  for (int i = 2; i <= 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  BOOST_CHECK_EQUAL(&map.valueOf(1), &value);
+  BOOST_CHECK_EQUAL(it->second, "Alice");
+  thenMapContainsItems(map, expected);
+
+  Map<K> moved{std::move(map)};
+  Map<K> assigned;
+  assigned[7] = "Bob";
+  assigned = std::move(moved);
+
+  BOOST_CHECK_EQUAL(&assigned.valueOf(1), &value);
+  BOOST_CHECK_EQUAL(it->second, "Alice");
+  value = "Chuck";
+  BOOST_CHECK_EQUAL(assigned.valueOf(1), "Chuck");
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallMap_WhenCopyingAndMovingIt_ThenNodesAreNotRelocated,
+                              K,
+                              TestedKeyTypes)
+{
+  CountingMap<K> map;
+  map[42] = "Alice";
+  map[27] = "Bob";
+  map[13] = "Chuck";
+  const std::map<K, std::string> expected = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  const auto* item = &map.valueOf(27);
+  CountingMap<K> assigned;
+  assigned[1] = "Dave";
+  allocationCount = 0;
+
+  CountingMap<K> copy{map};
+  BOOST_CHECK_EQUAL(allocationCount, 1);
+  CountingMap<K> moved{std::move(map)};
+  assigned = std::move(moved);
+
+  BOOST_CHECK_EQUAL(allocationCount, 1);
+  BOOST_CHECK_EQUAL(&assigned.valueOf(27), item);
+  BOOST_CHECK_EQUAL(assigned.getBucketCount(), 1);
+  thenMapContainsItems(copy, expected);
+  thenMapContainsItems(assigned, expected);
+  BOOST_CHECK(copy == assigned);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(moved.begin() == moved.end());
+
+  std::size_t backward = 0;
+  for (auto it = assigned.end(); it != assigned.begin(); --it)
+    ++backward;
+  BOOST_CHECK_EQUAL(backward, 3);
+
+  moved[7] = "Eve";
+  BOOST_CHECK_EQUAL(moved.valueOf(7), "Eve");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenItemWhoseCopyThrows_WhenCopyingMap_ThenTargetIsLeftEmptyAndUsable,
+                              K,
+                              TestedKeyTypes)
+{
+  for (const int size : { 3, 100 })
+  {
+    using ThrowingMap = aisdi::HashMap<K, ThrowingValue>;
+    ThrowingMap map;
+    for (int i = 0; i < size; ++i)
+      map[i] = ThrowingValue(std::string(32, 'a' + i % 26));
+    ThrowingMap assigned;
+    assigned[1000] = ThrowingValue("Alice");
+
+    ThrowingValue::copiesLeft = size / 2;
+    BOOST_CHECK_THROW(ThrowingMap copy(map), std::runtime_error);
+    ThrowingValue::copiesLeft = size / 2;
+    BOOST_CHECK_THROW(assigned = map, std::runtime_error);
+    ThrowingValue::copiesLeft = -1;
+
+    BOOST_CHECK(assigned.isEmpty());
+    BOOST_CHECK(assigned.begin() == assigned.end());
+    assigned[7] = ThrowingValue("Bob");
+    BOOST_CHECK_EQUAL(assigned.valueOf(7).text, "Bob");
+    assigned = map;
+    BOOST_CHECK_EQUAL(assigned.getSize(), size);
+  }
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
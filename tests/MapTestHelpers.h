@@ -0,0 +1,24 @@
+#ifndef AISDI_MAPS_MAPTESTHELPERS_H
+#define AISDI_MAPS_MAPTESTHELPERS_H
+
+#include <string>
+#include <map>
+#include <boost/test/unit_test.hpp>
+
+//Sprawdza, że mapa dowolnego silnika zawiera dokładnie elementy z expected
+template<typename M>
+void thenMapContainsItems(const M &map,
+                          const std::map<typename M::key_type, std::string> &expected) {
+    BOOST_CHECK_EQUAL(map.getSize(), expected.size());
+
+    for (const auto &item : expected) {
+        const auto it = map.find(item.first);
+        BOOST_REQUIRE_MESSAGE(it != map.end(), "Missing required item with key: " << item.first);
+        BOOST_CHECK_MESSAGE(it->second == item.second,
+                            "Wrong value in map for key: " << item.first
+                                                           << " (expected: \"" << item.second
+                                                           << "\" got: \"" << it->second << "\")");
+    }
+}
+
+#endif /* AISDI_MAPS_MAPTESTHELPERS_H */
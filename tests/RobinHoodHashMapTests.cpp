@@ -0,0 +1,99 @@
+#include <RobinHoodHashMap.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <map>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "MapTestHelpers.h"
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+//Slot domowy to key / 100 - klucze z jednej setki zderzają się, a kolejność w tablicy jest przewidywalna
+template<typename K>
+struct HundredsHash {
+    std::size_t operator()(const K &key) const {
+        return static_cast<std::size_t>(key / 100);
+    }
+};
+
+template<typename K>
+using Map = aisdi::RobinHoodHashMap<K, std::string, HundredsHash<K>>;
+
+BOOST_AUTO_TEST_SUITE(RobinHoodHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenKeysWithSameHome_WhenAddingThem_ThenTheyFollowEachOtherInInsertionOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  std::vector<K> order;
+
+  for (int i = 0; i < 40; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+    order.push_back(i);
+  }
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK(map.find(40) == map.end());
+  auto orderIt = order.begin();
+  for (const auto& item : map)
+    BOOST_CHECK_EQUAL(item.first, *orderIt++);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRicherItemInTheWay_WhenAddingKeyFartherFromHome_ThenRicherItemIsDisplaced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  map[100] = "Rome";
+  map[0] = "Paris";
+  map[1] = "Berlin";
+  map[2] = "Madrid";
+
+  //100 ma dom w slocie 1, ale klucze 1 i 2 są dalej od domu (0), więc wypychają go aż do slotu 3
+  auto it = map.begin();
+  BOOST_CHECK_EQUAL((it++)->first, 0);
+  BOOST_CHECK_EQUAL((it++)->first, 1);
+  BOOST_CHECK_EQUAL((it++)->first, 2);
+  BOOST_CHECK_EQUAL((it++)->first, 100);
+  BOOST_CHECK(it == map.end());
+  BOOST_CHECK_EQUAL(map.valueOf(100), "Rome");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCluster_WhenRemovingFromTheMiddle_ThenFollowersAreShiftedBack,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 12; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+  map[100] = "Rome";
+  expected[100] = "Rome";
+
+  for (int i = 0; i < 12; i += 3)
+  {
+    map.remove(i);
+    expected.erase(i);
+  }
+
+  //Bez nagrobków: pozostałe elementy (razem z 100) zajmują kolejne sloty od slotu 0, bez dziur
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK(map.find(0) == map.end());
+  auto expectedIt = expected.begin();
+  for (const auto& item : map)
+    BOOST_CHECK_EQUAL(item.first, (expectedIt++)->first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+#include <SwissHashMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "MapTestHelpers.h"
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+template<typename K>
+using Map = aisdi::SwissHashMap<K, std::string>;
+
+template<typename K>
+using ScalarMap = aisdi::SwissHashMap<K, std::string, aisdi::swiss::ScalarGroup>;
+
+BOOST_AUTO_TEST_SUITE(SwissHashMapsTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithRemovedItems_WhenAddingAgain_ThenTombstonesAreReused,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+
+  for (int round = 0; round < 20; ++round)
+  {
+    for (int i = 0; i < 100; ++i)
+      map[round * 100 + i] = std::to_string(i);
+    for (int i = 0; i < 100; i += 2)
+      map.remove(round * 100 + i);
+  }
+  for (int round = 0; round < 20; ++round)
+    for (int i = 1; i < 100; i += 2)
+      expected[round * 100 + i] = std::to_string(i);
+
+  thenMapContainsItems(map, expected);
+
+  std::size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    ++visited;
+  BOOST_CHECK_EQUAL(visited, expected.size());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenScalarGroupMap_WhenAddingAndRemovingItems_ThenItBehavesLikeSimdMap,
+                              K,
+                              TestedKeyTypes)
+{
+  ScalarMap<K> scalar;
+  Map<K> simd;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    scalar[i * 3] = std::to_string(i);
+    simd[i * 3] = std::to_string(i);
+  }
+  for (int i = 0; i < 1000; i += 5)
+  {
+    scalar.remove(i * 3);
+    simd.remove(i * 3);
+  }
+
+  BOOST_CHECK_EQUAL(scalar.getSize(), simd.getSize());
+  for (const auto &item : simd)
+  {
+    const auto it = scalar.find(item.first);
+    BOOST_REQUIRE(it != scalar.end());
+    BOOST_CHECK_EQUAL(it->second, item.second);
+  }
+  BOOST_CHECK(scalar.find(0) == scalar.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
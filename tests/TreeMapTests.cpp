@@ -1,6 +1,7 @@
 #include <TreeMap.h>
 
 #include <map>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -589,6 +590,470 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMissingKey_WhenTryEmplacing_ThenItemIsConstructedInPlace,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+
+  const auto result = map.tryEmplace(27, 3, 'x');
+
+  BOOST_CHECK(result.second);
+  BOOST_CHECK_EQUAL(result.first->first, 27);
+  BOOST_CHECK_EQUAL(result.first->second, "xxx");
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "xxx" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenExistingKey_WhenTryEmplacing_ThenValueIsNotChanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  const auto result = map.tryEmplace(42, "Chuck");
+
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK(result.first == map.find(42));
+  BOOST_CHECK_EQUAL(result.first->second, "Alice");
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyItems_WhenIteratingForward_ThenKeysAreSorted,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 500; ++i)
+  {
+    const int key = (i * 7919) % 1000;
+    map[key] = std::to_string(i);
+    expected[key] = std::to_string(i);
+  }
+  for (int i = 0; i < 1000; i += 3)
+  {
+    if (expected.erase(i))
+      map.remove(i);
+  }
+
+  auto expectedIt = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expectedIt)
+  {
+    BOOST_REQUIRE(expectedIt != expected.end());
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+  }
+  BOOST_CHECK(expectedIt == expected.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapWithManyItems_WhenIteratingBackward_ThenKeysAreReverseSorted,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 500; ++i)
+  {
+    const int key = (i * 7919) % 1000;
+    map[key] = std::to_string(i);
+    expected[key] = std::to_string(i);
+  }
+
+  auto expectedIt = expected.rbegin();
+  auto it = map.end();
+  while (it != map.begin())
+  {
+    --it;
+    BOOST_REQUIRE(expectedIt != expected.rend());
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+    ++expectedIt;
+  }
+  BOOST_CHECK(expectedIt == expected.rend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAccessingFrontOrBack_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK_THROW(map.front(), std::out_of_range);
+  BOOST_CHECK_THROW(map.back(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRemovingExtremeItems_ThenFrontAndBackAreUpdated,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" }, { 99, "Dave" } };
+
+  BOOST_CHECK_EQUAL(map.front().first, 13);
+  BOOST_CHECK_EQUAL(map.back().first, 99);
+
+  map.remove(13);
+  map.remove(99);
+  map[50] = "Eve";
+
+  BOOST_CHECK_EQUAL(map.front().first, 27);
+  BOOST_CHECK_EQUAL(map.back().second, "Eve");
+  BOOST_CHECK(map.begin() == map.find(27));
+  BOOST_CHECK((--map.end()) == map.find(50));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyInterleavedInsertionsAndRemovals_WhenCheckingMap_ThenItemsMatch,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const int key = (i * 7919) % 4096;
+    if (i % 3 == 2 && expected.erase(key))
+      map.remove(key);
+    else
+    {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+  }
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK_EQUAL(map.front().first, expected.begin()->first);
+  BOOST_CHECK_EQUAL(map.back().first, expected.rbegin()->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenExistingKey_WhenInserting_ThenValueIsUpdatedWithoutNewItem,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  const auto fresh = map.insert(13, "Chuck");
+  const auto existing = map.insert(42, "Dave");
+
+  BOOST_CHECK(fresh.second);
+  BOOST_CHECK_EQUAL(fresh.first->first, 13);
+  BOOST_CHECK(!existing.second);
+  BOOST_CHECK(existing.first == map.find(42));
+  thenMapContainsItems(map, { { 42, "Dave" }, { 27, "Bob" }, { 13, "Chuck" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInitializerListWithRepeatedKey_WhenCreatingMap_ThenKeyIsStoredOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 42, "Chuck" } };
+
+  BOOST_CHECK_EQUAL(map.getSize(), 2);
+  BOOST_CHECK_EQUAL(map.valueOf(42), "Chuck");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRemovingItemsByIteratorInLoop_ThenSuccessorsAreReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = std::to_string(i);
+
+  int expectedKey = 0;
+  for (auto it = map.begin(); it != map.end();)
+  {
+    BOOST_CHECK_EQUAL(it->first, expectedKey);
+    if (expectedKey % 2 == 0)
+      it = map.remove(it);
+    else
+      ++it;
+    ++expectedKey;
+  }
+
+  BOOST_CHECK_EQUAL(map.getSize(), 50);
+  BOOST_CHECK_EQUAL(map.front().first, 1);
+  BOOST_CHECK(map.remove(map.find(99)) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRemovedItem_WhenAddingNewItem_ThenNodeMemoryIsReused,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  const auto* removed = &*map.find(42);
+
+  map.remove(42);
+  map[13] = "Chuck";
+
+  BOOST_CHECK_EQUAL(static_cast<const void*>(&*map.find(13)), static_cast<const void*>(removed));
+  thenMapContainsItems(map, { { 27, "Bob" }, { 13, "Chuck" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenAssigningAndMoving_ThenItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 1000; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  Map<K> other = { { 42, "Alice" } };
+  other = map;
+  Map<K> moved{std::move(map)};
+  moved[1000] = "Bob";
+  other = std::move(moved);
+  expected[1000] = "Bob";
+
+  thenMapContainsItems(other, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSortedRange_WhenBuildingMap_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 1000; ++i)
+    expected[i * 2] = std::to_string(i);
+
+  Map<K> map = Map<K>::fromSorted(expected.begin(), expected.end());
+
+  thenMapContainsItems(map, expected);
+  BOOST_CHECK_EQUAL(map.front().first, 0);
+  BOOST_CHECK_EQUAL(map.back().first, 1998);
+
+  map[1] = "Alice";
+  map.remove(1000);
+  expected[1] = "Alice";
+  expected.erase(1000);
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSortedRangeWithRepeatedKeys_WhenBuildingMap_ThenLastValueIsKept,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::vector<std::pair<K, std::string>> items = {
+    { 13, "Alice" }, { 27, "Bob" }, { 27, "Chuck" }, { 42, "Dave" }, { 42, "Eve" }
+  };
+
+  const Map<K> map = Map<K>::fromSorted(items.begin(), items.end());
+
+  thenMapContainsItems(map, { { 13, "Alice" }, { 27, "Chuck" }, { 42, "Eve" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUnsortedRange_WhenBuildingFromSorted_ThenExceptionIsThrown,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::vector<std::pair<K, std::string>> items = { { 42, "Alice" }, { 27, "Bob" } };
+
+  BOOST_CHECK_THROW(Map<K>::fromSorted(items.begin(), items.end()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUnsortedRange_WhenBuildingFromUnsorted_ThenAllItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  const std::vector<std::pair<K, std::string>> items = {
+    { 42, "Alice" }, { 13, "Bob" }, { 27, "Chuck" }, { 13, "Dave" }
+  };
+
+  const Map<K> map = Map<K>::fromUnsorted(items.begin(), items.end());
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 13, "Dave" }, { 27, "Chuck" } });
+  BOOST_CHECK_EQUAL(map.begin()->first, 13);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeMap_WhenCopying_ThenCopyIsIndependentAndStillBalanced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 1000; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  Map<K> copy{map};
+  map.remove(500);
+  for (int i = 0; i < 1000; i += 2)
+  {
+    copy.remove(i);
+    expected.erase(i);
+  }
+  copy[2000] = "Alice";
+  expected[2000] = "Alice";
+
+  thenMapContainsItems(copy, expected);
+  BOOST_CHECK_EQUAL(copy.front().first, 1);
+  BOOST_CHECK_EQUAL(copy.back().first, 2000);
+  BOOST_CHECK_EQUAL(map.getSize(), 999);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsBuiltInDifferentOrder_WhenComparingThem_ThenTheyAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    other[99 - i] = std::to_string(99 - i);
+  }
+
+  BOOST_CHECK(map == other);
+  other.remove(50);
+  other[100] = "50";
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAssigningToItself_ThenItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  Map<K>& self = map;
+
+  map = self;
+
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenSearchingForBounds_ThenNeighbouringItemsAreReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = { { 10, "Alice" }, { 20, "Bob" }, { 30, "Chuck" } };
+
+  BOOST_CHECK_EQUAL(map.lowerBound(20)->first, 20);
+  BOOST_CHECK_EQUAL(map.lowerBound(15)->first, 20);
+  BOOST_CHECK_EQUAL(map.upperBound(20)->first, 30);
+  BOOST_CHECK_EQUAL(map.upperBound(5)->first, 10);
+  BOOST_CHECK(map.lowerBound(31) == map.end());
+  BOOST_CHECK(map.upperBound(30) == map.end());
+
+  const auto found = map.equalRange(20);
+  BOOST_CHECK(found.first == map.find(20));
+  BOOST_CHECK(found.second == map.find(30));
+  const auto missing = map.equalRange(25);
+  BOOST_CHECK(missing.first == missing.second);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenIteratingOverRange_ThenOnlyKeysInRangeAreVisited,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 100; ++i)
+    map[i * 2] = std::to_string(i);
+
+  std::vector<K> keys;
+  for (const auto& item : map.range(15, 25))
+    keys.push_back(item.first);
+
+  BOOST_CHECK((keys == std::vector<K>{ 16, 18, 20, 22, 24 }));
+  BOOST_CHECK(map.range(25, 15).isEmpty());
+  BOOST_CHECK(map.range(300, 400).isEmpty());
+
+  for (auto& item : map.range(0, 4))
+    item.second = "Alice";
+  BOOST_CHECK_EQUAL(map.valueOf(2), "Alice");
+  BOOST_CHECK_EQUAL(map.valueOf(4), "2");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenAskingForRanksAndNthItems_ThenOrderStatisticsAreReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 1000; ++i)
+    map[(i * 7919) % 1000 * 2] = std::to_string(i);
+  for (int i = 0; i < 200; ++i)
+    map.remove(i * 2);
+
+  BOOST_CHECK_EQUAL(map.rankOf(400), 0);
+  BOOST_CHECK_EQUAL(map.rankOf(401), 1);
+  BOOST_CHECK_EQUAL(map.rankOf(3000), 800);
+  BOOST_CHECK_EQUAL(map.nth(0)->first, 400);
+  BOOST_CHECK_EQUAL(map.nth(799)->first, 1998);
+  BOOST_CHECK_THROW(map.nth(800), std::out_of_range);
+  for (int i = 0; i < 800; i += 37)
+  {
+    BOOST_CHECK_EQUAL(map.nth(i)->first, 400 + 2 * i);
+    BOOST_CHECK_EQUAL(map.rankOf(400 + 2 * i), i);
+  }
+  BOOST_CHECK_EQUAL(map.distance(map.begin(), map.end()), 800);
+  BOOST_CHECK_EQUAL(map.distance(map.find(500), map.find(600)), 50);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallMap_WhenGrowingPastSmallSizeAndMoving_ThenReferencesStayValid,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  auto& value = map[1];
+  value = "Alice";
+  const auto it = map.find(1);
+  std::map<K, std::string> expected = { { 1, "Alice" } };
+
+  for (int i = 2; i <= 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    expected[i] = std::to_string(i);
+  }
+
+  BOOST_CHECK_EQUAL(&map.valueOf(1), &value);
+  BOOST_CHECK_EQUAL(it->second, "Alice");
+  thenMapContainsItems(map, expected);
+
+  Map<K> moved{std::move(map)};
+  Map<K> assigned;
+  assigned[7] = "Bob";
+  assigned = std::move(moved);
+
+  BOOST_CHECK_EQUAL(&assigned.valueOf(1), &value);
+  BOOST_CHECK_EQUAL(it->second, "Alice");
+  value = "Chuck";
+  BOOST_CHECK_EQUAL(assigned.valueOf(1), "Chuck");
+  BOOST_CHECK(map.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallMap_WhenMovingAndCopyingIt_ThenItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  const std::map<K, std::string> expected = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  const auto* item = &map.valueOf(27);
+
+  Map<K> moved{std::move(map)};
+  Map<K> copy{moved};
+  Map<K> assigned;
+  assigned = std::move(moved);
+
+  thenMapContainsItems(assigned, expected);
+  thenMapContainsItems(copy, expected);
+  BOOST_CHECK_EQUAL(&assigned.valueOf(27), item);
+  BOOST_CHECK(&copy.valueOf(27) != item);
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(moved.begin() == moved.end());
+
+  moved[7] = "Dave";
+  assigned.remove(27);
+  for (int i = 100; i < 120; ++i)
+    assigned[i] = "x";
+  assigned.remove(13);
+  assigned[14] = "Eve";
+  BOOST_CHECK_EQUAL(moved.valueOf(7), "Dave");
+  BOOST_CHECK_EQUAL(assigned.begin()->first, 14);
+  BOOST_CHECK_EQUAL((--assigned.end())->first, 119);
+  BOOST_CHECK_EQUAL(assigned.getSize(), 22);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 